@@ -0,0 +1,347 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarkHelper.hpp"
+#include "test/v1/test.grpc.pb.h"
+
+#include <agrpc/asioGrpc.hpp>
+#include <benchmark/benchmark.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/client_context.h>
+
+#ifdef AGRPC_STANDALONE_ASIO
+#include <asio/bind_executor.hpp>
+#include <asio/post.hpp>
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#endif
+#elif defined(AGRPC_BOOST_ASIO)
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#endif
+
+namespace asio = boost::asio;
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void BM_post_local(benchmark::State& state)
+{
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    std::size_t invocations{};
+    for (auto _ : state)
+    {
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       for (std::size_t i{}; i < bench::BATCH_SIZE; ++i)
+                       {
+                           asio::post(grpc_context,
+                                      [&]
+                                      {
+                                          ++invocations;
+                                      });
+                       }
+                   });
+        bench::run_until_out_of_work<agrpc::DefaultRunTraits>(grpc_context);
+    }
+    benchmark::DoNotOptimize(invocations);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+
+template <class Traits>
+void BM_post_remote(benchmark::State& state)
+{
+    const auto thread_count = static_cast<std::size_t>(state.range(0));
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    for (auto _ : state)
+    {
+        std::size_t remaining{thread_count * bench::BATCH_SIZE};
+        grpc_context.work_started();
+        std::vector<std::thread> threads;
+        for (std::size_t i{}; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    for (std::size_t j{}; j < bench::BATCH_SIZE; ++j)
+                    {
+                        asio::post(grpc_context,
+                                   [&]
+                                   {
+                                       if (0 == --remaining)
+                                       {
+                                           grpc_context.work_finished();
+                                       }
+                                   });
+                    }
+                });
+        }
+        bench::run_until_out_of_work<Traits>(grpc_context);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * thread_count * bench::BATCH_SIZE));
+}
+
+struct RepeatedWait
+{
+    agrpc::GrpcContext& grpc_context;
+    grpc::Alarm& alarm;
+    std::size_t& remaining;
+
+    void initiate() const
+    {
+        // A deadline in the past lets the alarm fire immediately
+        agrpc::wait(alarm, std::chrono::system_clock::time_point{}, asio::bind_executor(grpc_context, *this));
+    }
+
+    void operator()(bool) const
+    {
+        if (0 != --remaining)
+        {
+            initiate();
+        }
+    }
+};
+
+void BM_wait_alarm(benchmark::State& state)
+{
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    grpc::Alarm alarm;
+    for (auto _ : state)
+    {
+        std::size_t remaining{bench::BATCH_SIZE};
+        RepeatedWait{grpc_context, alarm, remaining}.initiate();
+        bench::run_until_out_of_work<agrpc::DefaultRunTraits>(grpc_context);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+
+struct UnaryClient
+{
+    test::v1::Test::Stub& stub;
+    agrpc::GrpcContext& grpc_context;
+    std::size_t& remaining;
+    agrpc::LatencyHistogram& histogram;
+    std::unique_ptr<grpc::ClientContext> client_context{};
+    std::unique_ptr<grpc::ClientAsyncResponseReader<test::msg::Response>> reader{};
+    test::msg::Request request{};
+    test::msg::Response response{};
+    grpc::Status status{};
+    std::chrono::steady_clock::time_point start{};
+
+    void initiate()
+    {
+        --remaining;
+        start = std::chrono::steady_clock::now();
+        client_context = std::make_unique<grpc::ClientContext>();
+        request.set_integer(42);
+        reader = stub.AsyncUnary(client_context.get(), request, grpc_context.get_completion_queue());
+        agrpc::finish(*reader, response, status,
+                      asio::bind_executor(grpc_context,
+                                          [this](bool)
+                                          {
+                                              histogram.record(std::chrono::steady_clock::now() - start);
+                                              if (0 != remaining)
+                                              {
+                                                  initiate();
+                                              }
+                                          }));
+    }
+};
+
+// Performs BATCH_SIZE unary requests per iteration, `concurrency` of them at a time, from a client GrpcContext that is
+// run by the benchmark thread
+template <class Traits>
+void run_unary_requests(benchmark::State& state, std::size_t concurrency)
+{
+    bench::InProcessServer server;
+    auto& server_grpc_context = server.server_grpc_context;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, server.service,
+        asio::bind_executor(server_grpc_context,
+                            [&](auto&& rpc_context)
+                            {
+                                test::msg::Response response;
+                                response.set_integer(rpc_context.request().integer());
+                                auto& writer = rpc_context.responder();
+                                agrpc::finish(writer, response, grpc::Status::OK,
+                                              asio::bind_executor(server_grpc_context,
+                                                                  [context = std::move(rpc_context)](bool) {}));
+                            }));
+    server.start_server_thread<Traits>();
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    auto histogram = std::make_unique<agrpc::LatencyHistogram>();
+    std::size_t remaining{};
+    std::vector<UnaryClient> clients;
+    clients.reserve(concurrency);
+    for (std::size_t i{}; i < concurrency; ++i)
+    {
+        clients.push_back(UnaryClient{*server.stub, grpc_context, remaining, *histogram});
+    }
+    for (auto _ : state)
+    {
+        remaining = bench::BATCH_SIZE;
+        for (auto& client : clients)
+        {
+            if (0 != remaining)
+            {
+                client.initiate();
+            }
+        }
+        bench::run_until_out_of_work<Traits>(grpc_context);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+    bench::report_latency_percentiles(state, *histogram);
+}
+
+template <class Traits>
+void BM_unary_round_trip(benchmark::State& state)
+{
+    run_unary_requests<Traits>(state, 1);
+}
+
+template <class Traits>
+void BM_repeatedly_request_dispatch(benchmark::State& state)
+{
+    run_unary_requests<Traits>(state, static_cast<std::size_t>(state.range(0)));
+}
+
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+// Rpc functions construct their operation inside of the awaiting coroutine's frame
+struct UseAwaitable
+{
+    static auto token() noexcept { return asio::use_awaitable; }
+};
+
+// Binding an allocator opts out of the above and allocates every operation from the GrpcContext's memory pool
+struct UsePooledAwaitable
+{
+    static auto token() noexcept { return agrpc::bind_allocator(std::allocator<std::byte>{}, asio::use_awaitable); }
+};
+
+template <class Function>
+void run_coroutine(agrpc::GrpcContext& grpc_context, Function function)
+{
+    asio::co_spawn(grpc_context, std::move(function), asio::detached);
+    bench::run_until_out_of_work<agrpc::DefaultRunTraits>(grpc_context);
+}
+
+template <class Token>
+void BM_wait_alarm_awaitable(benchmark::State& state)
+{
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    grpc::Alarm alarm;
+    for (auto _ : state)
+    {
+        run_coroutine(grpc_context,
+                      [&]() -> asio::awaitable<void>
+                      {
+                          for (std::size_t i{}; i < bench::BATCH_SIZE; ++i)
+                          {
+                              co_await agrpc::wait(alarm, std::chrono::system_clock::time_point{}, Token::token());
+                          }
+                      });
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+
+template <class Token>
+asio::awaitable<void> bidirectional_streaming_echo_server(bench::InProcessServer& server)
+{
+    grpc::ServerContext server_context;
+    grpc::ServerAsyncReaderWriter<test::msg::Response, test::msg::Request> reader_writer{&server_context};
+    co_await agrpc::request(&test::v1::Test::AsyncService::RequestBidirectionalStreaming, server.service,
+                            server_context, reader_writer, Token::token());
+    test::msg::Request request;
+    test::msg::Response response;
+    while (co_await agrpc::read(reader_writer, request, Token::token()))
+    {
+        response.set_integer(request.integer());
+        co_await agrpc::write(reader_writer, response, Token::token());
+    }
+    co_await agrpc::finish(reader_writer, grpc::Status::OK, Token::token());
+}
+
+// Performs BATCH_SIZE write and read round trips per iteration on a single bidirectional stream
+template <class Token>
+void BM_bidirectional_streaming_echo_awaitable(benchmark::State& state)
+{
+    bench::InProcessServer server;
+    asio::co_spawn(server.server_grpc_context, bidirectional_streaming_echo_server<Token>(server), asio::detached);
+    server.start_server_thread<agrpc::DefaultRunTraits>();
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    grpc::ClientContext client_context;
+    std::unique_ptr<grpc::ClientAsyncReaderWriter<test::msg::Request, test::msg::Response>> reader_writer;
+    run_coroutine(grpc_context,
+                  [&]() -> asio::awaitable<void>
+                  {
+                      co_await agrpc::request(&test::v1::Test::Stub::AsyncBidirectionalStreaming, *server.stub,
+                                              client_context, reader_writer, Token::token());
+                  });
+    for (auto _ : state)
+    {
+        run_coroutine(grpc_context,
+                      [&]() -> asio::awaitable<void>
+                      {
+                          test::msg::Request request;
+                          test::msg::Response response;
+                          for (std::size_t i{}; i < bench::BATCH_SIZE; ++i)
+                          {
+                              request.set_integer(static_cast<std::int32_t>(i));
+                              co_await agrpc::write(*reader_writer, request, Token::token());
+                              co_await agrpc::read(*reader_writer, response, Token::token());
+                          }
+                      });
+    }
+    run_coroutine(grpc_context,
+                  [&]() -> asio::awaitable<void>
+                  {
+                      co_await agrpc::writes_done(*reader_writer, Token::token());
+                      grpc::Status status;
+                      co_await agrpc::finish(*reader_writer, status, Token::token());
+                  });
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+#endif
+}  // namespace
+
+BENCHMARK(BM_post_local);
+BENCHMARK_TEMPLATE(BM_post_remote, agrpc::DefaultRunTraits)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_post_remote, bench::BusyPollRunTraits)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_wait_alarm);
+BENCHMARK_TEMPLATE(BM_unary_round_trip, agrpc::DefaultRunTraits)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_unary_round_trip, bench::BusyPollRunTraits)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_repeatedly_request_dispatch, agrpc::DefaultRunTraits)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_repeatedly_request_dispatch, bench::BatchRunTraits)->Arg(16)->Arg(64)->UseRealTime();
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+BENCHMARK_TEMPLATE(BM_wait_alarm_awaitable, UseAwaitable);
+BENCHMARK_TEMPLATE(BM_wait_alarm_awaitable, UsePooledAwaitable);
+BENCHMARK_TEMPLATE(BM_bidirectional_streaming_echo_awaitable, UseAwaitable)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_bidirectional_streaming_echo_awaitable, UsePooledAwaitable)->UseRealTime();
+#endif
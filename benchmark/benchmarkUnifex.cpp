@@ -0,0 +1,233 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmarkHelper.hpp"
+#include "test/v1/test.grpc.pb.h"
+
+#include <agrpc/asioGrpc.hpp>
+#include <benchmark/benchmark.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/client_context.h>
+#include <unifex/execute.hpp>
+#include <unifex/just.hpp>
+#include <unifex/let_value.hpp>
+#include <unifex/submit.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void BM_schedule_local(benchmark::State& state)
+{
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    std::size_t invocations{};
+    for (auto _ : state)
+    {
+        unifex::execute(grpc_context.get_scheduler(),
+                        [&]
+                        {
+                            for (std::size_t i{}; i < bench::BATCH_SIZE; ++i)
+                            {
+                                unifex::execute(grpc_context.get_scheduler(),
+                                                [&]
+                                                {
+                                                    ++invocations;
+                                                });
+                            }
+                        });
+        bench::run_until_out_of_work<agrpc::DefaultRunTraits>(grpc_context);
+    }
+    benchmark::DoNotOptimize(invocations);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+
+template <class Traits>
+void BM_schedule_remote(benchmark::State& state)
+{
+    const auto thread_count = static_cast<std::size_t>(state.range(0));
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    for (auto _ : state)
+    {
+        std::size_t remaining{thread_count * bench::BATCH_SIZE};
+        grpc_context.work_started();
+        std::vector<std::thread> threads;
+        for (std::size_t i{}; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    for (std::size_t j{}; j < bench::BATCH_SIZE; ++j)
+                    {
+                        unifex::execute(grpc_context.get_scheduler(),
+                                        [&]
+                                        {
+                                            if (0 == --remaining)
+                                            {
+                                                grpc_context.work_finished();
+                                            }
+                                        });
+                    }
+                });
+        }
+        bench::run_until_out_of_work<Traits>(grpc_context);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * thread_count * bench::BATCH_SIZE));
+}
+
+struct RepeatedWait
+{
+    agrpc::GrpcContext& grpc_context;
+    grpc::Alarm& alarm;
+    std::size_t& remaining;
+
+    void initiate() const
+    {
+        // A deadline in the past lets the alarm fire immediately
+        unifex::submit(
+            agrpc::wait(alarm, std::chrono::system_clock::time_point{}, agrpc::use_sender(grpc_context)),
+            bench::CallbackReceiver{*this});
+    }
+
+    void operator()(bool) const
+    {
+        if (0 != --remaining)
+        {
+            initiate();
+        }
+    }
+};
+
+void BM_wait_alarm(benchmark::State& state)
+{
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    grpc::Alarm alarm;
+    for (auto _ : state)
+    {
+        std::size_t remaining{bench::BATCH_SIZE};
+        RepeatedWait{grpc_context, alarm, remaining}.initiate();
+        bench::run_until_out_of_work<agrpc::DefaultRunTraits>(grpc_context);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+}
+
+struct UnaryClient
+{
+    test::v1::Test::Stub& stub;
+    agrpc::GrpcContext& grpc_context;
+    std::size_t& remaining;
+    agrpc::LatencyHistogram& histogram;
+    std::unique_ptr<grpc::ClientContext> client_context{};
+    std::unique_ptr<grpc::ClientAsyncResponseReader<test::msg::Response>> reader{};
+    test::msg::Request request{};
+    test::msg::Response response{};
+    grpc::Status status{};
+    std::chrono::steady_clock::time_point start{};
+
+    void initiate()
+    {
+        --remaining;
+        start = std::chrono::steady_clock::now();
+        client_context = std::make_unique<grpc::ClientContext>();
+        request.set_integer(42);
+        reader = stub.AsyncUnary(client_context.get(), request, grpc_context.get_completion_queue());
+        unifex::submit(agrpc::finish(*reader, response, status, agrpc::use_sender(grpc_context)),
+                       bench::CallbackReceiver{[this](bool)
+                                               {
+                                                   histogram.record(std::chrono::steady_clock::now() - start);
+                                                   if (0 != remaining)
+                                                   {
+                                                       initiate();
+                                                   }
+                                               }});
+    }
+};
+
+// Performs BATCH_SIZE unary requests per iteration, `concurrency` of them at a time, from a client GrpcContext that is
+// run by the benchmark thread
+template <class Traits>
+void run_unary_requests(benchmark::State& state, std::size_t concurrency)
+{
+    bench::InProcessServer server;
+    auto& server_grpc_context = server.server_grpc_context;
+    unifex::submit(agrpc::repeatedly_request(
+                       &test::v1::Test::AsyncService::RequestUnary, server.service,
+                       [&](grpc::ServerContext&, test::msg::Request& request,
+                           grpc::ServerAsyncResponseWriter<test::msg::Response>& writer)
+                       {
+                           return unifex::let_value(unifex::just(test::msg::Response{}),
+                                                    [&](test::msg::Response& response)
+                                                    {
+                                                        response.set_integer(request.integer());
+                                                        return agrpc::finish(writer, response, grpc::Status::OK,
+                                                                             agrpc::use_sender(server_grpc_context));
+                                                    });
+                       },
+                       agrpc::use_sender(server_grpc_context)),
+                   bench::CallbackReceiver{[] {}});
+    server.start_server_thread<Traits>();
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    auto histogram = std::make_unique<agrpc::LatencyHistogram>();
+    std::size_t remaining{};
+    std::vector<UnaryClient> clients;
+    clients.reserve(concurrency);
+    for (std::size_t i{}; i < concurrency; ++i)
+    {
+        clients.push_back(UnaryClient{*server.stub, grpc_context, remaining, *histogram});
+    }
+    for (auto _ : state)
+    {
+        remaining = bench::BATCH_SIZE;
+        for (auto& client : clients)
+        {
+            if (0 != remaining)
+            {
+                client.initiate();
+            }
+        }
+        bench::run_until_out_of_work<Traits>(grpc_context);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * bench::BATCH_SIZE));
+    bench::report_latency_percentiles(state, *histogram);
+}
+
+template <class Traits>
+void BM_unary_round_trip(benchmark::State& state)
+{
+    run_unary_requests<Traits>(state, 1);
+}
+
+template <class Traits>
+void BM_repeatedly_request_dispatch(benchmark::State& state)
+{
+    run_unary_requests<Traits>(state, static_cast<std::size_t>(state.range(0)));
+}
+}  // namespace
+
+BENCHMARK(BM_schedule_local);
+BENCHMARK_TEMPLATE(BM_schedule_remote, agrpc::DefaultRunTraits)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_schedule_remote, bench::BusyPollRunTraits)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_wait_alarm);
+BENCHMARK_TEMPLATE(BM_unary_round_trip, agrpc::DefaultRunTraits)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_unary_round_trip, bench::BusyPollRunTraits)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_repeatedly_request_dispatch, agrpc::DefaultRunTraits)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_repeatedly_request_dispatch, bench::BatchRunTraits)->Arg(16)->Arg(64)->UseRealTime();
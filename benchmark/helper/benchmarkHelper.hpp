@@ -0,0 +1,125 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_HELPER_BENCHMARKHELPER_HPP
+#define AGRPC_HELPER_BENCHMARKHELPER_HPP
+
+#include "test/v1/test.grpc.pb.h"
+
+#include <agrpc/grpcContext.hpp>
+#include <agrpc/latencyHistogram.hpp>
+#include <benchmark/benchmark.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace bench
+{
+// Number of operations that are performed per benchmark iteration
+inline constexpr std::size_t BATCH_SIZE = 1000;
+
+struct BatchRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr std::size_t MAX_COMPLETION_QUEUE_EVENTS = 64;
+};
+
+// Busy-polling only pays off when every spinning thread has a CPU core of its own, otherwise it starves the threads
+// that produce the work
+struct BusyPollRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr std::chrono::microseconds BUSY_POLL_DURATION{1000};
+};
+
+template <class Traits>
+void run_until_out_of_work(agrpc::GrpcContext& grpc_context)
+{
+    grpc_context.run<Traits>();
+    grpc_context.reset();
+}
+
+// A server that is only reachable through an in-process channel. Its GrpcContext is run by a separate thread which is
+// started by the benchmark after it has registered its request handlers.
+struct InProcessServer
+{
+    grpc::ServerBuilder builder;
+    test::v1::Test::AsyncService service;
+    agrpc::GrpcContext server_grpc_context{builder.AddCompletionQueue()};
+    std::unique_ptr<grpc::Server> server;
+    std::unique_ptr<test::v1::Test::Stub> stub;
+    std::thread server_thread;
+
+    InProcessServer()
+    {
+        builder.RegisterService(&service);
+        server = builder.BuildAndStart();
+        stub = test::v1::Test::NewStub(server->InProcessChannel(grpc::ChannelArguments{}));
+    }
+
+    ~InProcessServer()
+    {
+        stub.reset();
+        server->Shutdown();
+        if (server_thread.joinable())
+        {
+            server_thread.join();
+        }
+    }
+
+    template <class Traits>
+    void start_server_thread()
+    {
+        server_thread = std::thread{[&]
+                                    {
+                                        server_grpc_context.run<Traits>();
+                                    }};
+    }
+};
+
+template <class Function>
+struct CallbackReceiver
+{
+    Function function;
+
+    template <class... Args>
+    void set_value(Args&&... args)
+    {
+        function(std::forward<Args>(args)...);
+    }
+
+    void set_done() noexcept {}
+
+    void set_error(std::exception_ptr) noexcept {}
+};
+
+template <class Function>
+CallbackReceiver(Function) -> CallbackReceiver<Function>;
+
+inline void report_latency_percentiles(benchmark::State& state, const agrpc::LatencyHistogram& histogram)
+{
+    const auto to_microseconds = [](std::chrono::nanoseconds duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    state.counters["p50_us"] = to_microseconds(histogram.percentile(50.0));
+    state.counters["p99_us"] = to_microseconds(histogram.percentile(99.0));
+}
+}  // namespace bench
+
+#endif  // AGRPC_HELPER_BENCHMARKHELPER_HPP
@@ -12,7 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "buffer.hpp"
 #include "example/v1/exampleExt.grpc.pb.h"
 #include "helper.hpp"
 #include "scopeGuard.hpp"
@@ -42,22 +41,23 @@ agrpc::GrpcAwaitable<bool> make_double_buffered_send_file_request(agrpc::GrpcCon
     // Use a larger chunk size in production code, like 64'0000
     static constexpr std::size_t CHUNK_SIZE = 5;
 
-    // These buffers are used to customize allocation of completion handlers.
-    example::Buffer<250> buffer1;
-    example::Buffer<64> buffer2;
+    // These buffers are reused by sequential operations to avoid allocating their completion handlers. Operations that
+    // do not fit fall back to std::allocator.
+    agrpc::HandlerMemory<250> buffer1;
+    agrpc::HandlerMemory<64> buffer2;
 
     grpc::ClientContext client_context;
     client_context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
     google::protobuf::Empty response;
     std::unique_ptr<grpc::ClientAsyncWriter<example::v1::SendFileRequest>> writer;
     if (!co_await agrpc::request(&example::v1::ExampleExt::Stub::AsyncSendFile, stub, client_context, writer, response,
-                                 buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE)))
+                                 buffer1.bind(agrpc::GRPC_USE_AWAITABLE)))
     {
         co_return false;
     }
 
     // Switch to the io_context and open the file there to avoid blocking the GrpcContext.
-    co_await asio::post(buffer1.bind_allocator(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
+    co_await asio::post(buffer1.bind(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
 
     // Relying on CTAD here to create a `asio::basic_stream_file<asio::io_context::executor_type>` which is slightly
     // more performant than the default `asio::stream_file` that is templated on `asio::any_io_executor`.
@@ -73,7 +73,7 @@ agrpc::GrpcAwaitable<bool> make_double_buffered_send_file_request(agrpc::GrpcCon
     // We do not need to switch because agrpc::write is thread-safe.
     auto bytes_read = co_await file.async_read_some(
         asio::buffer(*first_read_buffer.mutable_content()),
-        buffer1.bind_allocator(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
+        buffer1.bind(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
 
     bool is_eof{false};
 
@@ -97,7 +97,7 @@ agrpc::GrpcAwaitable<bool> make_double_buffered_send_file_request(agrpc::GrpcCon
                     // agrpc::write.
                     file.async_read_some(
                         asio::buffer(*next->mutable_content()),
-                        buffer1.bind_allocator(asio::bind_executor(io_context, std::move(completion_handler))));
+                        buffer1.bind(asio::bind_executor(io_context, std::move(completion_handler))));
                 },
                 [&](auto&& completion_handler)
                 {
@@ -105,7 +105,7 @@ agrpc::GrpcAwaitable<bool> make_double_buffered_send_file_request(agrpc::GrpcCon
                     // executor.
                     agrpc::write(
                         *writer, *current,
-                        buffer2.bind_allocator(asio::bind_executor(grpc_context, std::move(completion_handler))));
+                        buffer2.bind(asio::bind_executor(grpc_context, std::move(completion_handler))));
                 });
         if (!ok)
         {
@@ -123,10 +123,10 @@ agrpc::GrpcAwaitable<bool> make_double_buffered_send_file_request(agrpc::GrpcCon
     // Signal that we are done sending chunks
     current->mutable_content()->resize(bytes_read);
     current->set_finish_write(true);
-    co_await agrpc::write_last(*writer, *current, {}, buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE));
+    co_await agrpc::write_last(*writer, *current, {}, buffer1.bind(agrpc::GRPC_USE_AWAITABLE));
 
     grpc::Status status;
-    co_await agrpc::finish(*writer, status, buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE));
+    co_await agrpc::finish(*writer, status, buffer1.bind(agrpc::GRPC_USE_AWAITABLE));
 
     co_return status.ok();
 }
@@ -12,7 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "buffer.hpp"
 #include "example/v1/example.grpc.pb.h"
 #include "example/v1/exampleExt.grpc.pb.h"
 #include "helper.hpp"
@@ -40,14 +39,15 @@ agrpc::GrpcAwaitable<bool> handle_send_file_request(agrpc::GrpcContext& grpc_con
                                                     example::v1::ExampleExt::AsyncService& service,
                                                     const std::string& file_path)
 {
-    // These buffers are used to customize allocation of completion handlers.
-    example::Buffer<320> buffer1;
-    example::Buffer<64> buffer2;
+    // These buffers are reused by sequential operations to avoid allocating their completion handlers. Operations that
+    // do not fit fall back to std::allocator.
+    agrpc::HandlerMemory<320> buffer1;
+    agrpc::HandlerMemory<64> buffer2;
 
     grpc::ServerContext server_context;
     grpc::ServerAsyncReader<google::protobuf::Empty, example::v1::SendFileRequest> responder{&server_context};
     if (!co_await agrpc::request(&example::v1::ExampleExt::AsyncService::RequestSendFile, service, server_context,
-                                 responder, buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE)))
+                                 responder, buffer1.bind(agrpc::GRPC_USE_AWAITABLE)))
     {
         // Server is shutting down.
         co_return false;
@@ -56,20 +56,20 @@ agrpc::GrpcAwaitable<bool> handle_send_file_request(agrpc::GrpcContext& grpc_con
     example::v1::SendFileRequest first_write_buffer;
 
     // Read the first chunk from the client
-    bool ok = co_await agrpc::read(responder, first_write_buffer, buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE));
+    bool ok = co_await agrpc::read(responder, first_write_buffer, buffer1.bind(agrpc::GRPC_USE_AWAITABLE));
 
     bool finish_write = first_write_buffer.finish_write();
     if (!ok && !finish_write)
     {
         // Client hang up or forgot to set finish_write.
-        co_await agrpc::finish(responder, {}, grpc::Status::OK, buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE));
+        co_await agrpc::finish(responder, {}, grpc::Status::OK, buffer1.bind(agrpc::GRPC_USE_AWAITABLE));
         co_return false;
     }
 
     example::v1::SendFileRequest second_write_buffer;
 
     // Switch to the io_context and open the file there to avoid blocking the GrpcContext.
-    co_await asio::post(buffer1.bind_allocator(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
+    co_await asio::post(buffer1.bind(asio::bind_executor(io_context, agrpc::GRPC_USE_AWAITABLE)));
 
     // Relying on CTAD here to create a `asio::basic_stream_file<asio::io_context::executor_type>` which is slightly
     // more performant than the default `asio::stream_file` that is templated on `asio::any_io_executor`.
@@ -97,7 +97,7 @@ agrpc::GrpcAwaitable<bool> handle_send_file_request(agrpc::GrpcContext& grpc_con
                     // agrpc::read.
                     asio::async_write(
                         file, asio::buffer(message_to_write.content()), asio::transfer_all(),
-                        buffer1.bind_allocator(asio::bind_executor(io_context, std::move(completion_handler))));
+                        buffer1.bind(asio::bind_executor(io_context, std::move(completion_handler))));
                 }
             },
             [&](auto&& completion_handler)
@@ -112,7 +112,7 @@ agrpc::GrpcAwaitable<bool> handle_send_file_request(agrpc::GrpcContext& grpc_con
                     // executor.
                     agrpc::read(
                         responder, message_to_read,
-                        buffer2.bind_allocator(asio::bind_executor(grpc_context, std::move(completion_handler))));
+                        buffer2.bind(asio::bind_executor(grpc_context, std::move(completion_handler))));
                 }
             });
     };
@@ -137,7 +137,7 @@ agrpc::GrpcAwaitable<bool> handle_send_file_request(agrpc::GrpcContext& grpc_con
     }
 
     co_return co_await agrpc::finish(responder, {}, grpc::Status::OK,
-                                     buffer1.bind_allocator(agrpc::GRPC_USE_AWAITABLE));
+                                     buffer1.bind(agrpc::GRPC_USE_AWAITABLE));
 }
 
 void run_io_context(asio::io_context& io_context)
@@ -19,9 +19,6 @@
 #include <agrpc/asioGrpc.hpp>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/detached.hpp>
-#include <boost/asio/experimental/awaitable_operators.hpp>
-#include <boost/asio/experimental/channel.hpp>
-#include <boost/asio/redirect_error.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <grpcpp/server.h>
@@ -116,59 +113,17 @@ void register_client_streaming_handler(example::v1::Example::AsyncService& servi
 }
 
 // The following bidirectional streaming example shows how to dispatch requests to a thread_pool and write responses
-// back to the client.
-using Channel = asio::experimental::channel<void(boost::system::error_code, example::v1::Request)>;
-
-asio::awaitable<void> reader(grpc::ServerAsyncReaderWriter<example::v1::Response, example::v1::Request>& reader_writer,
-                             Channel& channel)
-{
-    bool ok{true};
-    while (ok)
-    {
-        example::v1::Request request;
-        if (!co_await agrpc::read(reader_writer, request))
-        {
-            // Client is done writing.
-            break;
-        }
-        // Send request to writer. Using detached as completion token since we do not want to wait until the writer
-        // has picked up the request.
-        channel.async_send(boost::system::error_code{}, std::move(request), asio::detached);
-    }
-    // Signal the writer to complete.
-    channel.close();
-}
-
-asio::awaitable<bool> writer(grpc::ServerAsyncReaderWriter<example::v1::Response, example::v1::Request>& reader_writer,
-                             Channel& channel, asio::thread_pool& thread_pool)
-{
-    bool ok{true};
-    while (ok)
-    {
-        boost::system::error_code ec;
-        const auto request = co_await channel.async_receive(asio::redirect_error(asio::use_awaitable, ec));
-        if (ec)
-        {
-            // Channel got closed by the reader.
-            break;
-        }
-        // Switch to the thread_pool.
-        co_await asio::post(asio::bind_executor(thread_pool, asio::use_awaitable));
-        // Compute the response.
-        example::v1::Response response;
-        response.set_integer(request.integer() * 2);
-        // reader_writer is thread-safe so we can just interact with it from the thread_pool.
-        ok = co_await agrpc::write(reader_writer, response);
-        // Now we are back on the main thread.
-    }
-    co_return ok;
-}
+// back to the client. The agrpc::WriteQueue serializes writes that are initiated from the thread_pool. A write completes
+// as soon as its response has been handed to gRPC, so the next request is read while the previous response is still
+// being written.
+using ServerReaderWriter = grpc::ServerAsyncReaderWriter<example::v1::Response, example::v1::Request>;
 
 boost::asio::awaitable<void> handle_bidirectional_streaming_request(example::v1::Example::AsyncService& service,
+                                                                    agrpc::GrpcContext& grpc_context,
                                                                     boost::asio::thread_pool& thread_pool)
 {
     grpc::ServerContext server_context;
-    grpc::ServerAsyncReaderWriter<example::v1::Response, example::v1::Request> reader_writer{&server_context};
+    ServerReaderWriter reader_writer{&server_context};
     bool request_ok = co_await agrpc::request(&example::v1::Example::AsyncService::RequestBidirectionalStreaming,
                                               service, server_context, reader_writer);
     if (!request_ok)
@@ -176,10 +131,24 @@ boost::asio::awaitable<void> handle_bidirectional_streaming_request(example::v1:
         // Server is shutting down.
         co_return;
     }
-    Channel channel{co_await asio::this_coro::executor};
-
-    using namespace asio::experimental::awaitable_operators;
-    const auto ok = co_await(reader(reader_writer, channel) && writer(reader_writer, channel, thread_pool));
+    agrpc::WriteQueue<ServerReaderWriter> write_queue{grpc_context, reader_writer};
+    example::v1::Request request;
+    while (co_await agrpc::read(reader_writer, request))
+    {
+        // Switch to the thread_pool.
+        co_await asio::post(asio::bind_executor(thread_pool, asio::use_awaitable));
+        // Compute the response.
+        example::v1::Response response;
+        response.set_integer(request.integer() * 2);
+        // write_queue is thread-safe so we can just interact with it from the thread_pool.
+        if (!co_await write_queue.write(response))
+        {
+            break;
+        }
+        // Now we are back on the main thread.
+    }
+    // Wait for the last response to be written.
+    const bool ok = co_await write_queue.flush();
 
     if (!ok)
     {
@@ -257,7 +226,7 @@ int main(int argc, const char** argv)
         grpc_context,
         [&]() -> boost::asio::awaitable<void>
         {
-            co_await handle_bidirectional_streaming_request(service, thread_pool);
+            co_await handle_bidirectional_streaming_request(service, grpc_context, thread_pool);
         },
         boost::asio::detached);
     boost::asio::co_spawn(
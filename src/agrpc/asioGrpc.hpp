@@ -34,14 +34,22 @@
 #include "agrpc/defaultCompletionToken.hpp"
 #include "agrpc/getCompletionQueue.hpp"
 #include "agrpc/grpcContext.hpp"
+#include "agrpc/grpcContextPool.hpp"
 #include "agrpc/grpcExecutor.hpp"
 #include "agrpc/grpcInitiate.hpp"
+#include "agrpc/handlerMemory.hpp"
+#include "agrpc/latencyHistogram.hpp"
+#include "agrpc/operationType.hpp"
 #include "agrpc/pollContext.hpp"
 #include "agrpc/repeatedlyRequest.hpp"
 #include "agrpc/repeatedlyRequestContext.hpp"
+#include "agrpc/repeatedlyRequestOptions.hpp"
 #include "agrpc/rpc.hpp"
+#include "agrpc/streamReader.hpp"
+#include "agrpc/unaryCall.hpp"
 #include "agrpc/useAwaitable.hpp"
 #include "agrpc/useSender.hpp"
 #include "agrpc/wait.hpp"
+#include "agrpc/writeQueue.hpp"
 
 #endif  // AGRPC_AGRPC_ASIOGRPC_HPP
@@ -0,0 +1,96 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_ADMISSIONCONTROL_HPP
+#define AGRPC_DETAIL_ADMISSIONCONTROL_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/grpcContextImplementation.hpp"
+#include "agrpc/repeatedlyRequestOptions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+// Decides whether an incoming RPC is admitted according to an agrpc::RepeatedlyRequestAdmissionPolicy. Must only be
+// used by the thread that runs the GrpcContext.
+class AdmissionControl
+{
+  private:
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+  public:
+    explicit AdmissionControl(const agrpc::RepeatedlyRequestAdmissionPolicy& policy) noexcept
+        : max_in_flight(policy.max_in_flight_handlers),
+          max_outstanding_work(policy.max_outstanding_work),
+          requests_per_second(policy.requests_per_second),
+          burst_size(static_cast<double>((std::max)(std::size_t{1}, policy.burst_size))),
+          tokens(burst_size)
+    {
+    }
+
+    [[nodiscard]] bool is_enabled() const noexcept
+    {
+        return max_in_flight != 0 || max_outstanding_work > 0 || requests_per_second > 0.0;
+    }
+
+    [[nodiscard]] bool try_admit(const agrpc::GrpcContext& grpc_context, std::size_t in_flight) noexcept
+    {
+        if (max_in_flight != 0 && in_flight >= max_in_flight)
+        {
+            return false;
+        }
+        if (max_outstanding_work > 0 &&
+            detail::GrpcContextImplementation::get_outstanding_work(grpc_context) >= max_outstanding_work)
+        {
+            return false;
+        }
+        return requests_per_second <= 0.0 || this->try_acquire_token();
+    }
+
+  private:
+    bool try_acquire_token() noexcept
+    {
+        const auto now = Clock::now();
+        if (last_refill != Clock::time_point{})
+        {
+            const auto elapsed = std::chrono::duration_cast<Seconds>(now - last_refill).count();
+            tokens = (std::min)(burst_size, tokens + elapsed * requests_per_second);
+        }
+        last_refill = now;
+        if (tokens < 1.0)
+        {
+            return false;
+        }
+        tokens -= 1.0;
+        return true;
+    }
+
+    std::size_t max_in_flight;
+    long max_outstanding_work;
+    double requests_per_second;
+    double burst_size;
+    double tokens;
+    Clock::time_point last_refill{};
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_ADMISSIONCONTROL_HPP
@@ -21,10 +21,18 @@
 #include "agrpc/detail/operation.hpp"
 #include "agrpc/grpcContext.hpp"
 
+#include <memory>
+
 AGRPC_NAMESPACE_BEGIN()
 
 namespace detail
 {
+template <class Allocator>
+inline constexpr bool IS_STD_ALLOCATOR = false;
+
+template <class T>
+inline constexpr bool IS_STD_ALLOCATOR<std::allocator<T>> = true;
+
 template <bool IsIntrusivelyListable, class Handler, class Signature>
 struct AllocateOperationFn
 {
@@ -62,15 +70,35 @@ void allocate_operation_and_invoke(agrpc::GrpcContext& grpc_context, bool is_run
     using DecayedHandler = std::decay_t<Handler>;
     grpc_context.work_started();
     detail::WorkFinishedOnExit on_exit{grpc_context};
-    if (is_running_in_this_thread)
+    if (is_running_in_this_thread && !detail::GrpcContextImplementation::is_multithreaded(grpc_context))
     {
         auto operation = detail::allocate_operation<IsIntrusivelyListable, DecayedHandler, Signature>(
             grpc_context, work_allocator, std::forward<Args>(args)...);
         std::forward<OnLocalOperation>(on_local_operation)(grpc_context, operation.get());
         operation.release();
     }
+    else if (is_running_in_this_thread)
+    {
+        // The local memory pool is not thread-safe, operations might complete on a different thread
+        auto operation = detail::allocate_operation<IsIntrusivelyListable, DecayedHandler, Signature>(
+            work_allocator, std::forward<Args>(args)...);
+        std::forward<OnLocalOperation>(on_local_operation)(grpc_context, operation.get());
+        operation.release();
+    }
     else
     {
+        if constexpr (detail::IS_STD_ALLOCATOR<WorkAllocator>)
+        {
+            if (detail::GrpcContextImplementation::is_remote_memory_pool_enabled(grpc_context))
+            {
+                auto operation = detail::allocate_operation<IsIntrusivelyListable, DecayedHandler, Signature>(
+                    detail::GrpcContextImplementation::get_remote_allocator(grpc_context), std::forward<Args>(args)...);
+                std::forward<OnRemoteOperation>(on_remote_operation)(grpc_context, operation.get());
+                operation.release();
+                on_exit.release();
+                return;
+            }
+        }
         auto operation = detail::allocate_operation<IsIntrusivelyListable, DecayedHandler, Signature>(
             work_allocator, std::forward<Args>(args)...);
         std::forward<OnRemoteOperation>(on_remote_operation)(grpc_context, operation.get());
@@ -109,6 +137,16 @@ void create_and_submit_no_arg_operation(agrpc::GrpcContext& grpc_context, Handle
             return;
         }
     }
+    if (detail::GrpcContextImplementation::is_work_stealing_enabled(grpc_context))
+    {
+        // Posted operations of a work-stealing GrpcContext are always submitted to the remote work queue where idle
+        // siblings can steal them
+        detail::allocate_operation_and_invoke<true, Handler, void()>(
+            grpc_context, false, &detail::GrpcContextImplementation::add_local_operation,
+            &detail::GrpcContextImplementation::add_stealable_operation, work_allocator,
+            std::forward<Handler>(handler));
+        return;
+    }
     detail::allocate_operation_and_invoke<true, Handler, void()>(
         grpc_context, is_running_in_this_thread, &detail::GrpcContextImplementation::add_local_operation,
         &detail::GrpcContextImplementation::add_remote_operation, work_allocator, std::forward<Handler>(handler));
@@ -0,0 +1,112 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_ARENARPCCONTEXT_HPP
+#define AGRPC_DETAIL_ARENARPCCONTEXT_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/rpc.hpp"
+#include "agrpc/detail/rpcContext.hpp"
+
+#include <google/protobuf/arena.h>
+#include <grpcpp/server_context.h>
+
+#include <new>
+#include <tuple>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+template <class Request, class Responder>
+class ArenaMultiArgRPCContext : public detail::RPCContextBase
+{
+  public:
+    using Signature = void(grpc::ServerContext&, Request&, Responder&);
+
+    ArenaMultiArgRPCContext() = default;
+
+    auto args() noexcept { return std::forward_as_tuple(this->server_context(), *this->request_, this->responder_); }
+
+    auto& request() noexcept { return *this->request_; }
+
+    constexpr auto& responder() noexcept { return this->responder_; }
+
+    constexpr auto& arena() noexcept { return this->arena_; }
+
+    // Frees everything that has been allocated on the arena during the previous RPC while retaining its memory blocks
+    void recycle()
+    {
+        this->responder_.~Responder();
+        this->reset_server_context();
+        ::new (static_cast<void*>(&this->responder_)) Responder{&this->server_context()};
+        this->arena_.Reset();
+        this->request_ = google::protobuf::Arena::CreateMessage<Request>(&this->arena_);
+    }
+
+  private:
+    google::protobuf::Arena arena_;
+    Request* request_{google::protobuf::Arena::CreateMessage<Request>(&this->arena_)};
+    Responder responder_{&this->server_context()};
+};
+
+template <class Responder>
+class ArenaSingleArgRPCContext : public detail::RPCContextBase
+{
+  public:
+    using Signature = void(grpc::ServerContext&, Responder&);
+
+    ArenaSingleArgRPCContext() = default;
+
+    constexpr auto args() noexcept { return std::forward_as_tuple(this->server_context(), this->responder_); }
+
+    constexpr auto& responder() noexcept { return this->responder_; }
+
+    constexpr auto& arena() noexcept { return this->arena_; }
+
+    void recycle()
+    {
+        this->responder_.~Responder();
+        this->reset_server_context();
+        ::new (static_cast<void*>(&this->responder_)) Responder{&this->server_context()};
+        this->arena_.Reset();
+    }
+
+  private:
+    google::protobuf::Arena arena_;
+    Responder responder_{&this->server_context()};
+};
+
+template <class>
+struct ArenaRPCContextForRPC;
+
+template <class RPC, class Request, class Responder>
+struct ArenaRPCContextForRPC<detail::ServerMultiArgRequest<RPC, Request, Responder>>
+{
+    using Type = detail::ArenaMultiArgRPCContext<Request, Responder>;
+};
+
+template <class RPC, class Responder>
+struct ArenaRPCContextForRPC<detail::ServerSingleArgRequest<RPC, Responder>>
+{
+    using Type = detail::ArenaSingleArgRPCContext<Responder>;
+};
+
+template <class RPC>
+using ArenaRPCContextForRPCT = typename detail::ArenaRPCContextForRPC<detail::RemoveCvrefT<RPC>>::Type;
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_ARENARPCCONTEXT_HPP
@@ -46,6 +46,12 @@
 #include <asio/use_awaitable.hpp>
 
 #define AGRPC_ASIO_HAS_CO_AWAIT
+
+// Versions for which it has been verified that async_result<use_awaitable_t>::initiate keeps the initiation object alive
+// in its coroutine frame until the completion handler has been invoked
+#if (ASIO_VERSION >= 101700) && (ASIO_VERSION < 102300)
+#define AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+#endif
 #endif
 
 #if (ASIO_VERSION >= 102000)
@@ -83,6 +89,12 @@
 #include <boost/asio/use_awaitable.hpp>
 
 #define AGRPC_ASIO_HAS_CO_AWAIT
+
+// Versions for which it has been verified that async_result<use_awaitable_t>::initiate keeps the initiation object alive
+// in its coroutine frame until the completion handler has been invoked
+#if (BOOST_VERSION >= 107400) && (BOOST_VERSION < 107900)
+#define AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+#endif
 #endif
 
 #if (BOOST_VERSION >= 107700)
@@ -52,6 +52,10 @@ class AtomicIntrusiveQueue
     [[nodiscard]] bool try_mark_active() noexcept
     {
         void* old_value = this->producer_inactive_value();
+        if (this->head.load(std::memory_order_relaxed) != old_value)
+        {
+            return false;
+        }
         return this->head.compare_exchange_strong(old_value, nullptr, std::memory_order_acquire,
                                                   std::memory_order_relaxed);
     }
@@ -97,6 +101,24 @@ class AtomicIntrusiveQueue
         return detail::IntrusiveQueue<Item>::make_reversed(static_cast<Item*>(old_value));
     }
 
+    // Dequeue all pending items from the queue without changing the producer state.
+    //
+    // Returns an empty queue if the producer is marked as inactive.
+    [[nodiscard]] detail::IntrusiveQueue<Item> dequeue_all() noexcept
+    {
+        void* const inactive = this->producer_inactive_value();
+        void* old_value = this->head.load(std::memory_order_relaxed);
+        do
+        {
+            if (old_value == nullptr || old_value == inactive)
+            {
+                return {};
+            }
+        } while (!this->head.compare_exchange_weak(old_value, nullptr, std::memory_order_acquire,
+                                                   std::memory_order_relaxed));
+        return detail::IntrusiveQueue<Item>::make_reversed(static_cast<Item*>(old_value));
+    }
+
   private:
     [[nodiscard]] void* producer_inactive_value() const noexcept
     {
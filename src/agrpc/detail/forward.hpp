@@ -18,6 +18,7 @@
 #include "agrpc/detail/config.hpp"
 #include "agrpc/detail/grpcExecutorOptions.hpp"
 
+#include <cstddef>
 #include <memory>
 
 AGRPC_NAMESPACE_BEGIN()
@@ -27,6 +28,14 @@ class BasicGrpcExecutor;
 
 class GrpcContext;
 
+template <std::size_t Capacity>
+class HandlerMemory;
+
+template <class T, std::size_t Capacity>
+class HandlerMemoryAllocator;
+
+struct RepeatedlyRequestArenaOptions;
+
 namespace detail
 {
 template <class StopFunction>
@@ -35,6 +44,8 @@ struct GrpcInitiateImplFn;
 class RepeatedlyRequestFn;
 
 struct RepeatedlyRequestContextAccess;
+
+struct UnaryCallFn;
 }
 
 AGRPC_NAMESPACE_END
@@ -18,15 +18,30 @@
 #include "agrpc/detail/config.hpp"
 #include "agrpc/detail/memoryResource.hpp"
 #include "agrpc/detail/memoryResourceAllocator.hpp"
+#include "agrpc/detail/remoteMemoryPool.hpp"
+#include "agrpc/detail/slabMemoryResource.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 AGRPC_NAMESPACE_BEGIN()
 
 namespace detail
 {
-using GrpcContextLocalMemoryResource = detail::pmr::unsynchronized_pool_resource;
+using GrpcContextLocalMemoryResource = detail::SlabMemoryResource;
 using GrpcContextLocalAllocator = detail::MemoryResourceAllocator<std::byte, detail::GrpcContextLocalMemoryResource>;
+using GrpcContextRemoteAllocator = detail::MemoryResourceAllocator<std::byte, detail::RemoteMemoryPool>;
+
+struct GrpcContextMetricsCounters
+{
+    std::atomic_size_t completion_queue_events{};
+    std::atomic_size_t local_operations{};
+    std::atomic_size_t remote_operations{};
+    std::atomic_size_t work_alarm_wakeups{};
+    std::atomic<std::int64_t> blocked_nanoseconds{};
+    std::atomic_size_t max_local_queue_depth{};
+};
 }
 
 AGRPC_NAMESPACE_END
@@ -29,6 +29,8 @@
 #include <grpcpp/completion_queue.h>
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <thread>
 #include <utility>
 
@@ -43,7 +45,7 @@ struct AlwaysFalseCondition
 
 inline void drain_completion_queue(agrpc::GrpcContext& grpc_context)
 {
-    while (detail::GrpcContextImplementation::process_work<detail::InvokeHandler::NO>(
+    while (detail::GrpcContextImplementation::process_work<agrpc::DefaultRunTraits, detail::InvokeHandler::NO>(
         grpc_context, detail::AlwaysFalseCondition{}, detail::GrpcContextImplementation::INFINITE_FUTURE))
     {
         //
@@ -56,6 +58,18 @@ inline GrpcContext::GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& complet
 {
 }
 
+inline GrpcContext::GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& completion_queue,
+                                std::size_t concurrency_hint)
+    : is_multithreaded(concurrency_hint > 1), completion_queue(std::move(completion_queue))
+{
+}
+
+inline GrpcContext::GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& completion_queue,
+                                detail::pmr::memory_resource* upstream_resource)
+    : completion_queue(std::move(completion_queue)), local_resource(upstream_resource)
+{
+}
+
 inline GrpcContext::~GrpcContext()
 {
     this->stop();
@@ -68,14 +82,27 @@ inline GrpcContext::~GrpcContext()
 #endif
 }
 
-inline void GrpcContext::run() { detail::GrpcContextImplementation::run(*this); }
+inline void GrpcContext::run() { detail::GrpcContextImplementation::run<agrpc::DefaultRunTraits>(*this); }
+
+template <class Traits>
+inline void GrpcContext::run()
+{
+    detail::GrpcContextImplementation::run<Traits>(*this);
+}
+
+inline void GrpcContext::poll() { detail::GrpcContextImplementation::poll<agrpc::DefaultRunTraits>(*this); }
 
-inline void GrpcContext::poll() { detail::GrpcContextImplementation::poll(*this); }
+template <class Traits>
+inline void GrpcContext::poll()
+{
+    detail::GrpcContextImplementation::poll<Traits>(*this);
+}
 
 inline void GrpcContext::stop()
 {
     if (!this->stopped.exchange(true, std::memory_order_relaxed) &&
-        !detail::GrpcContextImplementation::running_in_this_thread(*this) && this->remote_work_queue.try_mark_active())
+        (this->is_multithreaded || !detail::GrpcContextImplementation::running_in_this_thread(*this)) &&
+        this->remote_work_queue.try_mark_active())
     {
         detail::GrpcContextImplementation::trigger_work_alarm(*this);
     }
@@ -94,6 +121,15 @@ inline GrpcContext::allocator_type GrpcContext::get_allocator() noexcept
     return GrpcContext::allocator_type{&this->local_resource};
 }
 
+inline void GrpcContext::reserve(std::size_t size, std::size_t count) { this->local_resource.reserve(size, count); }
+
+inline detail::pmr::memory_resource* GrpcContext::get_upstream_resource() const noexcept
+{
+    return this->local_resource.upstream_resource();
+}
+
+inline void GrpcContext::reserve_remote_operations(std::size_t count) { this->remote_resource.reserve(count); }
+
 inline void GrpcContext::work_started() noexcept { this->outstanding_work.fetch_add(1, std::memory_order_relaxed); }
 
 inline void GrpcContext::work_finished() noexcept
@@ -104,6 +140,17 @@ inline void GrpcContext::work_finished() noexcept
     }
 }
 
+inline agrpc::GrpcContextMetrics GrpcContext::metrics() const noexcept
+{
+    const auto& counters = this->metrics_counters;
+    return {counters.completion_queue_events.load(std::memory_order_relaxed),
+            counters.local_operations.load(std::memory_order_relaxed),
+            counters.remote_operations.load(std::memory_order_relaxed),
+            counters.work_alarm_wakeups.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds{counters.blocked_nanoseconds.load(std::memory_order_relaxed)},
+            counters.max_local_queue_depth.load(std::memory_order_relaxed)};
+}
+
 inline grpc::CompletionQueue* GrpcContext::get_completion_queue() noexcept { return this->completion_queue.get(); }
 
 inline grpc::ServerCompletionQueue* GrpcContext::get_server_completion_queue() noexcept
@@ -17,17 +17,31 @@
 
 #include "agrpc/detail/config.hpp"
 #include "agrpc/detail/grpcCompletionQueueEvent.hpp"
+#include "agrpc/detail/grpcContext.hpp"
+#include "agrpc/detail/intrusiveQueue.hpp"
 #include "agrpc/detail/typeErasedOperation.hpp"
 #include "agrpc/detail/utility.hpp"
 
 #include <grpcpp/completion_queue.h>
 
+#include <cstddef>
+#include <vector>
+
 AGRPC_NAMESPACE_BEGIN()
 
 class GrpcContext;
 
+struct RunRoundStatistics;
+
 namespace detail
 {
+using LocalWorkQueue = detail::IntrusiveQueue<detail::TypeErasedNoArgOperation>;
+
+struct WorkStealingGroup
+{
+    std::vector<agrpc::GrpcContext*> grpc_contexts;
+};
+
 struct WorkFinishedOnExitFunctor
 {
     agrpc::GrpcContext& grpc_context;
@@ -51,10 +65,28 @@ struct GrpcContextImplementation
 
     [[nodiscard]] static bool is_shutdown(const agrpc::GrpcContext& grpc_context) noexcept;
 
+    [[nodiscard]] static long get_outstanding_work(const agrpc::GrpcContext& grpc_context) noexcept;
+
+    [[nodiscard]] static bool is_multithreaded(const agrpc::GrpcContext& grpc_context) noexcept;
+
+    [[nodiscard]] static bool is_work_stealing_enabled(const agrpc::GrpcContext& grpc_context) noexcept;
+
+    static void set_work_stealing_group(agrpc::GrpcContext& grpc_context, detail::WorkStealingGroup* group) noexcept;
+
+    [[nodiscard]] static bool is_remote_memory_pool_enabled(const agrpc::GrpcContext& grpc_context) noexcept;
+
+    [[nodiscard]] static detail::GrpcContextRemoteAllocator get_remote_allocator(
+        agrpc::GrpcContext& grpc_context) noexcept;
+
+    [[nodiscard]] static detail::LocalWorkQueue& get_local_work_queue(agrpc::GrpcContext& grpc_context) noexcept;
+
     static void trigger_work_alarm(agrpc::GrpcContext& grpc_context) noexcept;
 
     static void add_remote_operation(agrpc::GrpcContext& grpc_context, detail::TypeErasedNoArgOperation* op) noexcept;
 
+    static void add_stealable_operation(agrpc::GrpcContext& grpc_context,
+                                        detail::TypeErasedNoArgOperation* op) noexcept;
+
     static void add_local_operation(agrpc::GrpcContext& grpc_context, detail::TypeErasedNoArgOperation* op) noexcept;
 
     static void add_operation(agrpc::GrpcContext& grpc_context, detail::TypeErasedNoArgOperation* op) noexcept;
@@ -67,18 +99,51 @@ struct GrpcContextImplementation
 
     static const agrpc::GrpcContext* set_thread_local_grpc_context(const agrpc::GrpcContext* grpc_context) noexcept;
 
+    template <class Traits>
+    static void append_remote_work(agrpc::GrpcContext& grpc_context, detail::LocalWorkQueue remote_work) noexcept;
+
+    template <class Traits>
     static bool move_remote_work_to_local_queue(agrpc::GrpcContext& grpc_context) noexcept;
 
-    template <detail::InvokeHandler Invoke>
-    static void process_local_queue(agrpc::GrpcContext& grpc_context);
+    static void acquire_remote_work_queue(agrpc::GrpcContext& grpc_context) noexcept;
+
+    template <class Traits>
+    static bool release_remote_work_queue(agrpc::GrpcContext& grpc_context) noexcept;
+
+    static void wake_up_next_thread(agrpc::GrpcContext& grpc_context) noexcept;
+
+    static void move_local_work_to_remote_queue(agrpc::GrpcContext& grpc_context,
+                                                detail::LocalWorkQueue& local_work_queue) noexcept;
+
+    template <class Traits>
+    static bool steal_remote_work(agrpc::GrpcContext& grpc_context) noexcept;
+
+    static void wake_up_idle_sibling(agrpc::GrpcContext& grpc_context) noexcept;
+
+    template <class Traits, detail::InvokeHandler Invoke>
+    static std::size_t process_local_queue(agrpc::GrpcContext& grpc_context);
+
+    template <class Traits, detail::InvokeHandler Invoke>
+    static bool handle_next_completion_queue_event(agrpc::GrpcContext& grpc_context, ::gpr_timespec deadline);
+
+    template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
+    static bool wait_for_next_completion_queue_event(agrpc::GrpcContext& grpc_context, StopCondition& stop_condition,
+                                                     ::gpr_timespec deadline);
+
+    template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
+    static bool process_round(agrpc::GrpcContext& grpc_context, StopCondition stop_condition, ::gpr_timespec deadline,
+                              agrpc::RunRoundStatistics& statistics);
 
-    template <detail::InvokeHandler Invoke, class StopCondition>
+    template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
     static bool process_work(agrpc::GrpcContext& grpc_context, StopCondition stop_condition, ::gpr_timespec deadline);
 
+    template <class Traits>
     static void process_work(agrpc::GrpcContext& grpc_context, ::gpr_timespec deadline);
 
+    template <class Traits>
     static void run(agrpc::GrpcContext& grpc_context);
 
+    template <class Traits>
     static void poll(agrpc::GrpcContext& grpc_context);
 };
 }
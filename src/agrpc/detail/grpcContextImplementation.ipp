@@ -19,12 +19,18 @@
 #include "agrpc/detail/grpcCompletionQueueEvent.hpp"
 #include "agrpc/detail/grpcContextImplementation.hpp"
 #include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/detail/utility.hpp"
 #include "agrpc/grpcContext.hpp"
 
 #include <grpcpp/completion_queue.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <utility>
 
 AGRPC_NAMESPACE_BEGIN()
 
@@ -45,6 +51,9 @@ struct GrpcContextThreadContext : asio::detail::thread_context
 
 inline thread_local const agrpc::GrpcContext* thread_local_grpc_context{};
 
+// Only used by GrpcContexts that have been constructed with a concurrency_hint greater than one
+inline thread_local detail::LocalWorkQueue* thread_local_work_queue{};
+
 struct ThreadLocalGrpcContextGuard
 {
     const agrpc::GrpcContext* old_context;
@@ -62,6 +71,33 @@ struct ThreadLocalGrpcContextGuard
     ThreadLocalGrpcContextGuard& operator=(ThreadLocalGrpcContextGuard&&) = delete;
 };
 
+struct ThreadLocalWorkQueueGuard
+{
+    agrpc::GrpcContext& grpc_context;
+    detail::LocalWorkQueue local_work_queue;
+    detail::LocalWorkQueue* old_work_queue;
+
+    explicit ThreadLocalWorkQueueGuard(agrpc::GrpcContext& grpc_context) noexcept
+        : grpc_context(grpc_context), old_work_queue{std::exchange(detail::thread_local_work_queue, &local_work_queue)}
+    {
+    }
+
+    ~ThreadLocalWorkQueueGuard()
+    {
+        detail::thread_local_work_queue = old_work_queue;
+        detail::GrpcContextImplementation::move_local_work_to_remote_queue(grpc_context, local_work_queue);
+        if (grpc_context.is_stopped())
+        {
+            detail::GrpcContextImplementation::wake_up_next_thread(grpc_context);
+        }
+    }
+
+    ThreadLocalWorkQueueGuard(const ThreadLocalWorkQueueGuard&) = delete;
+    ThreadLocalWorkQueueGuard(ThreadLocalWorkQueueGuard&&) = delete;
+    ThreadLocalWorkQueueGuard& operator=(const ThreadLocalWorkQueueGuard&) = delete;
+    ThreadLocalWorkQueueGuard& operator=(ThreadLocalWorkQueueGuard&&) = delete;
+};
+
 struct IsGrpcContextStoppedCondition
 {
     const agrpc::GrpcContext& grpc_context;
@@ -76,6 +112,50 @@ inline bool GrpcContextImplementation::is_shutdown(const agrpc::GrpcContext& grp
     return grpc_context.shutdown.load(std::memory_order_relaxed);
 }
 
+inline long GrpcContextImplementation::get_outstanding_work(const agrpc::GrpcContext& grpc_context) noexcept
+{
+    return grpc_context.outstanding_work.load(std::memory_order_relaxed);
+}
+
+inline bool GrpcContextImplementation::is_multithreaded(const agrpc::GrpcContext& grpc_context) noexcept
+{
+    return grpc_context.is_multithreaded;
+}
+
+inline bool GrpcContextImplementation::is_work_stealing_enabled(const agrpc::GrpcContext& grpc_context) noexcept
+{
+    return grpc_context.work_stealing_group != nullptr;
+}
+
+inline void GrpcContextImplementation::set_work_stealing_group(agrpc::GrpcContext& grpc_context,
+                                                               detail::WorkStealingGroup* group) noexcept
+{
+    grpc_context.work_stealing_group = group;
+}
+
+inline bool GrpcContextImplementation::is_remote_memory_pool_enabled(const agrpc::GrpcContext& grpc_context) noexcept
+{
+    // Blocks of the pool must be deallocated by one thread at a time
+    return !grpc_context.remote_resource.empty() && !grpc_context.is_multithreaded &&
+           grpc_context.work_stealing_group == nullptr;
+}
+
+inline detail::GrpcContextRemoteAllocator GrpcContextImplementation::get_remote_allocator(
+    agrpc::GrpcContext& grpc_context) noexcept
+{
+    return detail::GrpcContextRemoteAllocator{&grpc_context.remote_resource};
+}
+
+inline detail::LocalWorkQueue& GrpcContextImplementation::get_local_work_queue(
+    agrpc::GrpcContext& grpc_context) noexcept
+{
+    if (grpc_context.is_multithreaded && detail::GrpcContextImplementation::running_in_this_thread(grpc_context))
+    {
+        return *detail::thread_local_work_queue;
+    }
+    return grpc_context.local_work_queue;
+}
+
 inline void GrpcContextImplementation::trigger_work_alarm(agrpc::GrpcContext& grpc_context) noexcept
 {
     grpc_context.work_alarm.Set(grpc_context.completion_queue.get(), detail::GrpcContextImplementation::TIME_ZERO,
@@ -91,10 +171,28 @@ inline void GrpcContextImplementation::add_remote_operation(agrpc::GrpcContext&
     }
 }
 
+// Stealable operations have their own queue, which is never marked as inactive. The remote work queue also holds
+// operations that are bound to the owning GrpcContext and must therefore never be stolen. Whether the owner is blocked
+// on its completion queue is still tracked by the remote work queue.
+inline void GrpcContextImplementation::add_stealable_operation(agrpc::GrpcContext& grpc_context,
+                                                               detail::TypeErasedNoArgOperation* op) noexcept
+{
+    (void)grpc_context.stealable_work_queue.enqueue(op);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (grpc_context.remote_work_queue.try_mark_active())
+    {
+        detail::GrpcContextImplementation::trigger_work_alarm(grpc_context);
+    }
+    else
+    {
+        detail::GrpcContextImplementation::wake_up_idle_sibling(grpc_context);
+    }
+}
+
 inline void GrpcContextImplementation::add_local_operation(agrpc::GrpcContext& grpc_context,
                                                            detail::TypeErasedNoArgOperation* op) noexcept
 {
-    grpc_context.local_work_queue.push_back(op);
+    detail::GrpcContextImplementation::get_local_work_queue(grpc_context).push_back(op);
 }
 
 inline void GrpcContextImplementation::add_operation(agrpc::GrpcContext& grpc_context,
@@ -121,27 +219,212 @@ inline const agrpc::GrpcContext* GrpcContextImplementation::set_thread_local_grp
     return std::exchange(detail::thread_local_grpc_context, grpc_context);
 }
 
-inline bool GrpcContextImplementation::move_remote_work_to_local_queue(agrpc::GrpcContext& grpc_context) noexcept
+inline void update_max(std::atomic_size_t& max, std::size_t value) noexcept
 {
-    auto remote_work_queue = grpc_context.remote_work_queue.try_mark_inactive_or_dequeue_all();
+    auto current = max.load(std::memory_order_relaxed);
+    while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+        //
+    }
+}
+
+template <class Traits>
+void GrpcContextImplementation::append_remote_work(agrpc::GrpcContext& grpc_context,
+                                                   detail::LocalWorkQueue remote_work) noexcept
+{
+    if constexpr (Traits::ENABLE_METRICS)
+    {
+        grpc_context.metrics_counters.remote_operations.fetch_add(remote_work.size(), std::memory_order_relaxed);
+    }
+    detail::GrpcContextImplementation::get_local_work_queue(grpc_context).append(std::move(remote_work));
+}
+
+template <class Traits>
+bool GrpcContextImplementation::move_remote_work_to_local_queue(agrpc::GrpcContext& grpc_context) noexcept
+{
+    auto remote_work_queue = grpc_context.remote_work_queue.dequeue_all();
+    remote_work_queue.append(grpc_context.stealable_work_queue.dequeue_all());
     if (remote_work_queue.empty())
     {
         return false;
     }
-    grpc_context.local_work_queue.append(std::move(remote_work_queue));
+    detail::GrpcContextImplementation::append_remote_work<Traits>(grpc_context, std::move(remote_work_queue));
     return true;
 }
 
-template <detail::InvokeHandler Invoke>
-void GrpcContextImplementation::process_local_queue(agrpc::GrpcContext& grpc_context)
+// While the remote work queue is marked as active, remote producers enqueue without triggering the work alarm and
+// the queue is polled at the beginning of every round instead. It is only marked as inactive right before the thread
+// blocks on the completion queue. That way a busy GrpcContext is never woken up through the gRPC alarm machinery.
+//
+// When multiple threads run the GrpcContext then check_remote_work is shared among them. Only the thread that
+// successfully exchanges it from true to false may mark the queue as inactive.
+inline void GrpcContextImplementation::acquire_remote_work_queue(agrpc::GrpcContext& grpc_context) noexcept
+{
+    if (!grpc_context.check_remote_work.load(std::memory_order_relaxed) &&
+        grpc_context.remote_work_queue.try_mark_active())
+    {
+        grpc_context.check_remote_work.store(true, std::memory_order_relaxed);
+    }
+}
+
+template <class Traits>
+bool GrpcContextImplementation::release_remote_work_queue(agrpc::GrpcContext& grpc_context) noexcept
+{
+    if (!grpc_context.check_remote_work.exchange(false, std::memory_order_relaxed))
+    {
+        return true;
+    }
+    auto remote_work_queue = grpc_context.remote_work_queue.try_mark_inactive_or_dequeue_all();
+    if (remote_work_queue.empty())
+    {
+        return true;
+    }
+    grpc_context.check_remote_work.store(true, std::memory_order_relaxed);
+    detail::GrpcContextImplementation::append_remote_work<Traits>(grpc_context, std::move(remote_work_queue));
+    return false;
+}
+
+// A stopped GrpcContext that is run by multiple threads must wake up the threads that are still blocked on the
+// completion queue. Every thread that exits passes the work alarm on to the next one.
+inline void GrpcContextImplementation::wake_up_next_thread(agrpc::GrpcContext& grpc_context) noexcept
+{
+    if (grpc_context.check_remote_work.exchange(false, std::memory_order_relaxed) ||
+        grpc_context.remote_work_queue.try_mark_active())
+    {
+        detail::GrpcContextImplementation::trigger_work_alarm(grpc_context);
+    }
+}
+
+inline void GrpcContextImplementation::move_local_work_to_remote_queue(
+    agrpc::GrpcContext& grpc_context, detail::LocalWorkQueue& local_work_queue) noexcept
 {
-    auto queue{std::move(grpc_context.local_work_queue)};
+    while (!local_work_queue.empty())
+    {
+        detail::GrpcContextImplementation::add_remote_operation(grpc_context, local_work_queue.pop_front());
+    }
+}
+
+template <class Function>
+bool find_work_stealing_sibling(agrpc::GrpcContext& grpc_context, const detail::WorkStealingGroup& group,
+                                Function function)
+{
+    const auto& grpc_contexts = group.grpc_contexts;
+    const auto size = grpc_contexts.size();
+    const auto self = static_cast<std::size_t>(
+        std::find(grpc_contexts.begin(), grpc_contexts.end(), &grpc_context) - grpc_contexts.begin());
+    for (std::size_t i = 1; i < size; ++i)
+    {
+        if (function(*grpc_contexts[(self + i) % size]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Only operations of the stealable work queue may be stolen. They are posted completion handlers that have been
+// allocated using their associated allocator and can therefore be completed by any thread. The outstanding work is
+// transferred from the sibling to the stealing GrpcContext before the operations are completed.
+//
+// A GrpcContext that is about to block looks for work in its own and its siblings' stealable work queues after marking
+// its remote work queue as inactive while add_stealable_operation() and wake_up_idle_sibling() check for inactive
+// queues after enqueuing. The fences ensure that at least one of them observes the other.
+template <class Traits>
+bool GrpcContextImplementation::steal_remote_work(agrpc::GrpcContext& grpc_context) noexcept
+{
+    if (grpc_context.work_stealing_group == nullptr)
+    {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (auto own_work = grpc_context.stealable_work_queue.dequeue_all(); !own_work.empty())
+    {
+        detail::GrpcContextImplementation::append_remote_work<Traits>(grpc_context, std::move(own_work));
+        return true;
+    }
+    if (detail::GrpcContextImplementation::is_shutdown(grpc_context))
+    {
+        return false;
+    }
+    return detail::find_work_stealing_sibling(
+        grpc_context, *grpc_context.work_stealing_group,
+        [&](agrpc::GrpcContext& sibling)
+        {
+            auto stolen_work = sibling.stealable_work_queue.dequeue_all();
+            if (stolen_work.empty())
+            {
+                return false;
+            }
+            const auto count = static_cast<long>(stolen_work.size());
+            detail::GrpcContextImplementation::append_remote_work<Traits>(grpc_context, std::move(stolen_work));
+            grpc_context.outstanding_work.fetch_add(count, std::memory_order_relaxed);
+            if AGRPC_UNLIKELY (count == sibling.outstanding_work.fetch_sub(count, std::memory_order_relaxed))
+            {
+                sibling.stop();
+            }
+            return true;
+        });
+}
+
+// A sibling whose remote work queue is marked as inactive is blocked on its completion queue. Waking it up through
+// its work alarm causes it to look for work to steal.
+inline void GrpcContextImplementation::wake_up_idle_sibling(agrpc::GrpcContext& grpc_context) noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    detail::find_work_stealing_sibling(grpc_context, *grpc_context.work_stealing_group,
+                                       [](agrpc::GrpcContext& sibling)
+                                       {
+                                           if (sibling.remote_work_queue.try_mark_active())
+                                           {
+                                               detail::GrpcContextImplementation::trigger_work_alarm(sibling);
+                                               return true;
+                                           }
+                                           return false;
+                                       });
+}
+
+template <class Traits, class Operation, class... Args>
+void complete_operation(agrpc::GrpcContext& grpc_context, Operation* operation, Args... args)
+{
+    if constexpr (Traits::ENABLE_OPERATION_TIMING)
+    {
+        // The operation is deallocated during completion
+        const auto operation_type = operation->operation_type();
+        const auto start = std::chrono::steady_clock::now();
+        operation->complete(args...);
+        const auto duration = std::chrono::steady_clock::now() - start;
+        Traits::on_operation_completed(grpc_context, operation_type,
+                                       std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    }
+    else
+    {
+        operation->complete(args...);
+    }
+}
+
+template <class Traits, detail::InvokeHandler Invoke>
+std::size_t GrpcContextImplementation::process_local_queue(agrpc::GrpcContext& grpc_context)
+{
+    static_assert(Traits::MAX_LOCAL_OPERATIONS > 0, "MAX_LOCAL_OPERATIONS must be greater than zero");
+    std::size_t processed{};
+    auto queue{std::move(detail::GrpcContextImplementation::get_local_work_queue(grpc_context))};
+    if constexpr (Traits::ENABLE_METRICS)
+    {
+        detail::update_max(grpc_context.metrics_counters.max_local_queue_depth, queue.size());
+    }
     while (!queue.empty())
     {
+        if (Traits::MAX_LOCAL_OPERATIONS == processed)
+        {
+            detail::GrpcContextImplementation::get_local_work_queue(grpc_context).prepend(std::move(queue));
+            break;
+        }
+        ++processed;
         detail::WorkFinishedOnExit on_exit{grpc_context};
         auto* operation = queue.pop_front();
-        operation->complete(Invoke, grpc_context.get_allocator());
+        detail::complete_operation<Traits>(grpc_context, operation, Invoke, grpc_context.get_allocator());
     }
+    return processed;
 }
 
 inline bool get_next_event(grpc::CompletionQueue* cq, detail::GrpcCompletionQueueEvent& event,
@@ -150,69 +433,199 @@ inline bool get_next_event(grpc::CompletionQueue* cq, detail::GrpcCompletionQueu
     return grpc::CompletionQueue::GOT_EVENT == cq->AsyncNext(&event.tag, &event.ok, deadline);
 }
 
-template <detail::InvokeHandler Invoke, class StopCondition>
-bool GrpcContextImplementation::process_work(agrpc::GrpcContext& grpc_context, StopCondition stop_condition,
-                                             ::gpr_timespec deadline)
+template <class Traits>
+bool get_next_event(grpc::CompletionQueue* cq, detail::GrpcCompletionQueueEvent& event, ::gpr_timespec deadline,
+                    std::atomic<std::int64_t>& blocked_nanoseconds) noexcept
 {
-    if (grpc_context.check_remote_work)
-    {
-        grpc_context.check_remote_work =
-            detail::GrpcContextImplementation::move_remote_work_to_local_queue(grpc_context);
-    }
-    detail::GrpcContextImplementation::process_local_queue<Invoke>(grpc_context);
-    if (stop_condition())
+    if constexpr (Traits::ENABLE_METRICS)
     {
-        return false;
+        if (0 != ::gpr_time_cmp(deadline, detail::GrpcContextImplementation::TIME_ZERO))
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto result = detail::get_next_event(cq, event, deadline);
+            const auto blocked_duration = std::chrono::steady_clock::now() - start;
+            blocked_nanoseconds.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(blocked_duration).count(),
+                std::memory_order_relaxed);
+            return result;
+        }
     }
-    const auto is_more_completed_work_pending =
-        grpc_context.check_remote_work || !grpc_context.local_work_queue.empty();
-    if (detail::GrpcCompletionQueueEvent event; detail::get_next_event(
-            grpc_context.get_completion_queue(), event,
-            is_more_completed_work_pending ? detail::GrpcContextImplementation::TIME_ZERO : deadline))
+    return detail::get_next_event(cq, event, deadline);
+}
+
+template <class Traits, detail::InvokeHandler Invoke>
+bool GrpcContextImplementation::handle_next_completion_queue_event(agrpc::GrpcContext& grpc_context,
+                                                                   ::gpr_timespec deadline)
+{
+    if (detail::GrpcCompletionQueueEvent event;
+        detail::get_next_event<Traits>(grpc_context.get_completion_queue(), event, deadline,
+                                       grpc_context.metrics_counters.blocked_nanoseconds))
     {
         if (detail::GrpcContextImplementation::HAS_REMOTE_WORK_TAG == event.tag)
         {
-            grpc_context.check_remote_work = true;
+            grpc_context.check_remote_work.store(true, std::memory_order_relaxed);
+            if constexpr (Traits::ENABLE_METRICS)
+            {
+                grpc_context.metrics_counters.work_alarm_wakeups.fetch_add(1, std::memory_order_relaxed);
+            }
         }
         else
         {
+            if constexpr (Traits::ENABLE_METRICS)
+            {
+                grpc_context.metrics_counters.completion_queue_events.fetch_add(1, std::memory_order_relaxed);
+            }
             detail::WorkFinishedOnExit on_exit{grpc_context};
             auto* operation = static_cast<detail::TypeErasedGrpcTagOperation*>(event.tag);
-            operation->complete(Invoke, event.ok, grpc_context.get_allocator());
+            detail::complete_operation<Traits>(grpc_context, operation, Invoke, event.ok, grpc_context.get_allocator());
         }
         return true;
     }
-    return is_more_completed_work_pending;
+    return false;
+}
+
+template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
+bool GrpcContextImplementation::wait_for_next_completion_queue_event(agrpc::GrpcContext& grpc_context,
+                                                                     StopCondition& stop_condition,
+                                                                     ::gpr_timespec deadline)
+{
+    if (0 == ::gpr_time_cmp(deadline, detail::GrpcContextImplementation::TIME_ZERO))
+    {
+        return detail::GrpcContextImplementation::handle_next_completion_queue_event<Traits, Invoke>(grpc_context,
+                                                                                                    deadline);
+    }
+    if constexpr (Traits::BUSY_POLL_DURATION.count() > 0)
+    {
+        const auto busy_poll_end = std::chrono::steady_clock::now() + Traits::BUSY_POLL_DURATION;
+        do
+        {
+            if (detail::GrpcContextImplementation::handle_next_completion_queue_event<Traits, Invoke>(
+                    grpc_context, detail::GrpcContextImplementation::TIME_ZERO))
+            {
+                return true;
+            }
+            if (stop_condition() ||
+                (grpc_context.check_remote_work.load(std::memory_order_relaxed) &&
+                 detail::GrpcContextImplementation::move_remote_work_to_local_queue<Traits>(grpc_context)) ||
+                detail::GrpcContextImplementation::steal_remote_work<Traits>(grpc_context))
+            {
+                return false;
+            }
+        } while (std::chrono::steady_clock::now() < busy_poll_end);
+    }
+    if (!detail::GrpcContextImplementation::release_remote_work_queue<Traits>(grpc_context) || stop_condition())
+    {
+        return false;
+    }
+    if (detail::GrpcContextImplementation::steal_remote_work<Traits>(grpc_context))
+    {
+        detail::GrpcContextImplementation::acquire_remote_work_queue(grpc_context);
+        return false;
+    }
+    return detail::GrpcContextImplementation::handle_next_completion_queue_event<Traits, Invoke>(grpc_context,
+                                                                                                deadline);
+}
+
+template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
+bool GrpcContextImplementation::process_round(agrpc::GrpcContext& grpc_context, StopCondition stop_condition,
+                                              ::gpr_timespec deadline, agrpc::RunRoundStatistics& statistics)
+{
+    static_assert(Traits::MAX_COMPLETION_QUEUE_EVENTS > 0, "MAX_COMPLETION_QUEUE_EVENTS must be greater than zero");
+    if (grpc_context.check_remote_work.load(std::memory_order_relaxed))
+    {
+        detail::GrpcContextImplementation::move_remote_work_to_local_queue<Traits>(grpc_context);
+    }
+    statistics.local_operations = detail::GrpcContextImplementation::process_local_queue<Traits, Invoke>(grpc_context);
+    if (stop_condition())
+    {
+        return false;
+    }
+    auto& local_work_queue = detail::GrpcContextImplementation::get_local_work_queue(grpc_context);
+    const auto next_deadline = local_work_queue.empty() ? deadline : detail::GrpcContextImplementation::TIME_ZERO;
+    if (!detail::GrpcContextImplementation::wait_for_next_completion_queue_event<Traits, Invoke>(
+            grpc_context, stop_condition, next_deadline))
+    {
+        return !local_work_queue.empty();
+    }
+    statistics.completion_queue_events = 1;
+    while (statistics.completion_queue_events < Traits::MAX_COMPLETION_QUEUE_EVENTS && !stop_condition() &&
+           detail::GrpcContextImplementation::handle_next_completion_queue_event<Traits, Invoke>(
+               grpc_context, detail::GrpcContextImplementation::TIME_ZERO))
+    {
+        ++statistics.completion_queue_events;
+    }
+    return true;
+}
+
+template <class Traits, detail::InvokeHandler Invoke, class StopCondition>
+bool GrpcContextImplementation::process_work(agrpc::GrpcContext& grpc_context, StopCondition stop_condition,
+                                             ::gpr_timespec deadline)
+{
+    agrpc::RunRoundStatistics statistics{};
+    const auto result = detail::GrpcContextImplementation::process_round<Traits, Invoke>(
+        grpc_context, std::move(stop_condition), deadline, statistics);
+    if constexpr (Traits::ENABLE_METRICS)
+    {
+        grpc_context.metrics_counters.local_operations.fetch_add(statistics.local_operations,
+                                                                 std::memory_order_relaxed);
+    }
+    Traits::on_round_completed(grpc_context, std::as_const(statistics));
+    return result;
 }
 
-inline void GrpcContextImplementation::process_work(agrpc::GrpcContext& grpc_context, ::gpr_timespec deadline)
+template <class Traits>
+void GrpcContextImplementation::process_work(agrpc::GrpcContext& grpc_context, ::gpr_timespec deadline)
 {
     if (grpc_context.outstanding_work.load(std::memory_order_relaxed) == 0)
     {
         grpc_context.stopped.store(true, std::memory_order_relaxed);
         return;
     }
-    grpc_context.reset();
+    // A thread that joins others which are already running the GrpcContext must not undo a stop() that they might
+    // have observed already
+    if (0 == grpc_context.running_threads.fetch_add(1, std::memory_order_relaxed))
+    {
+        grpc_context.reset();
+    }
+    detail::ScopeGuard running_threads_guard{[&]
+                                             {
+                                                 grpc_context.running_threads.fetch_sub(1, std::memory_order_relaxed);
+                                             }};
+    detail::GrpcContextImplementation::acquire_remote_work_queue(grpc_context);
 #if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
     detail::GrpcContextThreadContext thread_context;
 #endif
     detail::ThreadLocalGrpcContextGuard guard{grpc_context};
-    while (detail::GrpcContextImplementation::process_work<detail::InvokeHandler::YES>(
-        grpc_context, detail::IsGrpcContextStoppedCondition{grpc_context}, deadline))
-
+    const auto run = [&]
     {
-        //
+        while (detail::GrpcContextImplementation::process_work<Traits, detail::InvokeHandler::YES>(
+            grpc_context, detail::IsGrpcContextStoppedCondition{grpc_context}, deadline))
+        {
+            //
+        }
+    };
+    if (grpc_context.is_multithreaded)
+    {
+        detail::ThreadLocalWorkQueueGuard work_queue_guard{grpc_context};
+        run();
+    }
+    else
+    {
+        run();
     }
 }
 
-inline void GrpcContextImplementation::run(agrpc::GrpcContext& grpc_context)
+template <class Traits>
+void GrpcContextImplementation::run(agrpc::GrpcContext& grpc_context)
 {
-    detail::GrpcContextImplementation::process_work(grpc_context, detail::GrpcContextImplementation::INFINITE_FUTURE);
+    detail::GrpcContextImplementation::process_work<Traits>(grpc_context,
+                                                            detail::GrpcContextImplementation::INFINITE_FUTURE);
 }
 
-inline void GrpcContextImplementation::poll(agrpc::GrpcContext& grpc_context)
+template <class Traits>
+void GrpcContextImplementation::poll(agrpc::GrpcContext& grpc_context)
 {
-    detail::GrpcContextImplementation::process_work(grpc_context, detail::GrpcContextImplementation::TIME_ZERO);
+    detail::GrpcContextImplementation::process_work<Traits>(grpc_context, detail::GrpcContextImplementation::TIME_ZERO);
 }
 }
 
@@ -37,8 +37,19 @@ struct GrpcInitiateImplFn
     template <class InitiatingFunction, class CompletionToken = detail::DefaultCompletionToken>
     auto operator()(InitiatingFunction initiating_function, CompletionToken token = {}) const
     {
-        return asio::async_initiate<CompletionToken, void(bool)>(
-            detail::GrpcInitiator<InitiatingFunction, StopFunction>{std::move(initiating_function)}, token);
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+        if constexpr (detail::IS_USE_AWAITABLE<CompletionToken>)
+        {
+            return asio::async_initiate<CompletionToken, void(bool)>(
+                detail::GrpcAwaitableInitiator<InitiatingFunction, StopFunction>{std::move(initiating_function)},
+                token);
+        }
+        else
+#endif
+        {
+            return asio::async_initiate<CompletionToken, void(bool)>(
+                detail::GrpcInitiator<InitiatingFunction, StopFunction>{std::move(initiating_function)}, token);
+        }
     }
 #endif
 
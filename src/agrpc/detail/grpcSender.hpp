@@ -25,6 +25,7 @@
 #include "agrpc/detail/typeErasedOperation.hpp"
 #include "agrpc/detail/utility.hpp"
 #include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
 
 #include <boost/optional.hpp>
 
@@ -76,6 +77,7 @@ class GrpcSender : public detail::SenderOf<bool>
             }
             this->grpc_context().work_started();
             detail::WorkFinishedOnExit on_exit{this->grpc_context()};
+            this->set_operation_type(detail::OPERATION_TYPE_V<InitiatingFunction>);
             this->initiating_function()(this->grpc_context(), this);
             on_exit.release();
         }
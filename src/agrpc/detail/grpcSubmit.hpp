@@ -19,6 +19,7 @@
 #include "agrpc/detail/config.hpp"
 #include "agrpc/detail/grpcContextImplementation.hpp"
 #include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
 
 AGRPC_NAMESPACE_BEGIN()
 
@@ -28,9 +29,13 @@ template <class InitiatingFunction, class CompletionHandler, class Allocator>
 void grpc_submit(agrpc::GrpcContext& grpc_context, InitiatingFunction initiating_function,
                  CompletionHandler&& completion_handler, Allocator allocator)
 {
+    const auto initiate = [&](agrpc::GrpcContext& context, auto* operation)
+    {
+        operation->set_operation_type(detail::OPERATION_TYPE_V<InitiatingFunction>);
+        initiating_function(context, operation);
+    };
     detail::allocate_operation_and_invoke<false, CompletionHandler, void(bool)>(
-        grpc_context, initiating_function, initiating_function, allocator,
-        std::forward<CompletionHandler>(completion_handler));
+        grpc_context, initiate, initiate, allocator, std::forward<CompletionHandler>(completion_handler));
 }
 }
 
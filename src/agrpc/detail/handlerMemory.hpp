@@ -0,0 +1,47 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_HANDLERMEMORY_HPP
+#define AGRPC_DETAIL_HANDLERMEMORY_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/forward.hpp"
+#include "agrpc/detail/operation.hpp"
+#include "agrpc/detail/unbind.hpp"
+#include "agrpc/detail/utility.hpp"
+
+#include <cstddef>
+#include <utility>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+template <class CompletionHandler>
+using UnboundCompletionHandlerT =
+    detail::RemoveCvrefT<decltype(detail::unbind_recursively(std::declval<CompletionHandler>()))>;
+
+// The capacity does not affect the size of the allocator, it only stores a pointer to the HandlerMemory.
+using SizingHandlerMemoryAllocator = agrpc::HandlerMemoryAllocator<std::byte, 1>;
+
+// RPC functions and agrpc::wait submit their operation through detail::grpc_submit
+template <class CompletionHandler>
+inline constexpr std::size_t HANDLER_MEMORY_SIZE =
+    sizeof(detail::Operation<false, detail::UnboundCompletionHandlerT<CompletionHandler>,
+                             detail::SizingHandlerMemoryAllocator, void(bool)>);
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_HANDLERMEMORY_HPP
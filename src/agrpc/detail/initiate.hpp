@@ -22,11 +22,15 @@
 #include "agrpc/detail/grpcContextImplementation.hpp"
 #include "agrpc/detail/grpcSender.hpp"
 #include "agrpc/detail/grpcSubmit.hpp"
+#include "agrpc/detail/oneShotAllocator.hpp"
+#include "agrpc/detail/operation.hpp"
 #include "agrpc/detail/queryGrpcContext.hpp"
 #include "agrpc/detail/unbind.hpp"
 #include "agrpc/detail/useSender.hpp"
 #include "agrpc/grpcContext.hpp"
 
+#include <cstddef>
+
 AGRPC_NAMESPACE_BEGIN()
 
 namespace detail
@@ -43,6 +47,14 @@ class GrpcInitiator
     void operator()(CompletionHandler&& completion_handler)
     {
         auto unbound = detail::unbind_and_get_associates(std::forward<CompletionHandler>(completion_handler));
+        const auto allocator = unbound.allocator();
+        this->submit(unbound, allocator);
+    }
+
+  protected:
+    template <class UnbindResult, class Allocator>
+    void submit(UnbindResult& unbound, Allocator allocator)
+    {
         auto& grpc_context = detail::query_grpc_context(unbound.executor());
         if AGRPC_UNLIKELY (detail::GrpcContextImplementation::is_shutdown(grpc_context))
         {
@@ -58,13 +70,61 @@ class GrpcInitiator
         }
 #endif
         detail::grpc_submit(grpc_context, std::move(this->initiating_function), std::move(unbound.completion_handler()),
-                            unbound.allocator());
+                            allocator);
     }
 
   private:
     InitiatingFunction initiating_function;
 };
 
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+// Initiator used for `asio::use_awaitable`. Asio moves the initiator into the frame of a coroutine that lives until the
+// completion handler has been invoked. The operation is therefore constructed in a buffer of this initiator instead of
+// being allocated from the GrpcContext's memory pool. That is an implementation detail of Asio, which is why
+// IS_USE_AWAITABLE only selects this initiator for the versions listed in asioForward.hpp.
+template <class InitiatingFunction, class StopFunction = detail::Empty, std::size_t BufferSize = 128>
+class GrpcAwaitableInitiator : public detail::GrpcInitiator<InitiatingFunction, StopFunction>
+{
+  private:
+    using Base = detail::GrpcInitiator<InitiatingFunction, StopFunction>;
+
+  public:
+    static constexpr std::size_t BUFFER_SIZE = BufferSize;
+
+    using Base::Base;
+
+    template <class CompletionHandler>
+    void operator()(CompletionHandler&& completion_handler)
+    {
+        using BufferAllocator = detail::OneShotAllocator<std::byte, BUFFER_SIZE>;
+        auto unbound = detail::unbind_and_get_associates(std::forward<CompletionHandler>(completion_handler));
+        using Handler = detail::RemoveCvrefT<decltype(unbound.completion_handler())>;
+        using Operation = detail::Operation<false, Handler, BufferAllocator, void(bool)>;
+        if constexpr (detail::IS_STD_ALLOCATOR<detail::RemoveCvrefT<decltype(unbound.allocator())>> &&
+                      sizeof(Operation) <= BUFFER_SIZE && alignof(Operation) <= alignof(std::max_align_t))
+        {
+            this->submit(unbound, BufferAllocator{&buffer});
+        }
+        else
+        {
+            const auto allocator = unbound.allocator();
+            this->submit(unbound, allocator);
+        }
+    }
+
+  private:
+    alignas(std::max_align_t) std::byte buffer[BUFFER_SIZE];
+};
+
+template <class CompletionToken>
+inline constexpr bool IS_USE_AWAITABLE = false;
+
+#ifdef AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+template <class Executor>
+inline constexpr bool IS_USE_AWAITABLE<asio::use_awaitable_t<Executor>> = true;
+#endif
+#endif
+
 template <class CompletionHandler, class Payload>
 class GrpcCompletionHandlerWithPayload : public detail::AssociatedCompletionHandler<CompletionHandler>
 {
@@ -17,6 +17,7 @@
 
 #include "agrpc/detail/config.hpp"
 
+#include <cstddef>
 #include <utility>
 
 AGRPC_NAMESPACE_BEGIN()
@@ -35,7 +36,9 @@ class IntrusiveQueue
     IntrusiveQueue& operator=(const IntrusiveQueue&) = delete;
 
     IntrusiveQueue(IntrusiveQueue&& other) noexcept
-        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr))
+        : head(std::exchange(other.head, nullptr)),
+          tail(std::exchange(other.tail, nullptr)),
+          count(std::exchange(other.count, 0))
     {
     }
 
@@ -45,6 +48,7 @@ class IntrusiveQueue
     {
         std::swap(head, other.head);
         std::swap(tail, other.tail);
+        std::swap(count, other.count);
         return *this;
     }
 
@@ -52,21 +56,26 @@ class IntrusiveQueue
     {
         Item* new_head = nullptr;
         Item* new_tail = list;
+        std::size_t new_count{};
         while (list != nullptr)
         {
             Item* next = list->next;
             list->next = new_head;
             new_head = list;
             list = next;
+            ++new_count;
         }
         IntrusiveQueue result;
         result.head = new_head;
         result.tail = new_tail;
+        result.count = new_count;
         return result;
     }
 
     [[nodiscard]] bool empty() const noexcept { return this->head == nullptr; }
 
+    [[nodiscard]] std::size_t size() const noexcept { return count; }
+
     [[nodiscard]] Item* pop_front() noexcept
     {
         Item* item = std::exchange(this->head, this->head->next);
@@ -74,6 +83,7 @@ class IntrusiveQueue
         {
             tail = nullptr;
         }
+        --count;
         return item;
     }
 
@@ -89,6 +99,7 @@ class IntrusiveQueue
             tail->next = item;
         }
         tail = item;
+        ++count;
     }
 
     void append(IntrusiveQueue other) noexcept
@@ -107,11 +118,32 @@ class IntrusiveQueue
             tail->next = other_head;
         }
         tail = std::exchange(other.tail, nullptr);
+        count += std::exchange(other.count, 0);
+    }
+
+    void prepend(IntrusiveQueue other) noexcept
+    {
+        if (other.empty())
+        {
+            return;
+        }
+        auto* other_tail = std::exchange(other.tail, nullptr);
+        if (this->empty())
+        {
+            tail = other_tail;
+        }
+        else
+        {
+            other_tail->next = this->head;
+        }
+        this->head = std::exchange(other.head, nullptr);
+        count += std::exchange(other.count, 0);
     }
 
   private:
     Item* head{nullptr};
     Item* tail{nullptr};
+    std::size_t count{};
 };
 }
 
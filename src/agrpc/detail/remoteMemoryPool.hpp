@@ -0,0 +1,171 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_REMOTEMEMORYPOOL_HPP
+#define AGRPC_DETAIL_REMOTEMEMORYPOOL_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/memoryResource.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+// Fixed capacity pool of equally sized blocks. Blocks may be allocated from any thread concurrently, lock-free, but
+// must be deallocated by one thread at a time. Deallocated blocks are first collected in an unsynchronized list and
+// handed back to the allocating threads in batches, or right away if the allocating threads have run out of blocks.
+// Requests that do not fit into a block or that arrive while the pool is exhausted are forwarded to the new-delete
+// resource.
+class RemoteMemoryPool
+{
+  public:
+    static constexpr std::size_t BLOCK_SIZE = 128;
+    static constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+    static constexpr std::size_t RETURN_BATCH_SIZE = 8;
+    static constexpr std::size_t MAX_BLOCK_COUNT = std::numeric_limits<std::uint32_t>::max() - 1;
+
+    RemoteMemoryPool() = default;
+
+    RemoteMemoryPool(const RemoteMemoryPool&) = delete;
+    RemoteMemoryPool(RemoteMemoryPool&&) = delete;
+    RemoteMemoryPool& operator=(const RemoteMemoryPool&) = delete;
+    RemoteMemoryPool& operator=(RemoteMemoryPool&&) = delete;
+
+    // Must be called before the first allocation, subsequent calls have no effect
+    void reserve(std::size_t count)
+    {
+        if (block_count != 0 || count == 0)
+        {
+            return;
+        }
+        count = (std::min)(count, MAX_BLOCK_COUNT);
+        blocks = std::make_unique<Block[]>(count);
+        next_indices = std::make_unique<std::atomic<std::uint32_t>[]>(count);
+        for (std::size_t i{}; i < count; ++i)
+        {
+            next_indices[i].store(i + 1 == count ? NIL : static_cast<std::uint32_t>(i + 1), std::memory_order_relaxed);
+        }
+        block_count = count;
+        head.store(0, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return block_count == 0; }
+
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if AGRPC_LIKELY (bytes <= BLOCK_SIZE && alignment <= BLOCK_ALIGNMENT)
+        {
+            if (auto* block = this->pop())
+            {
+                return block;
+            }
+        }
+        return detail::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if AGRPC_UNLIKELY (!this->owns(p))
+        {
+            detail::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            return;
+        }
+        const auto index = static_cast<std::uint32_t>(static_cast<Block*>(p) - blocks.get());
+        next_indices[index].store(returned_head, std::memory_order_relaxed);
+        if (returned_head == NIL)
+        {
+            returned_tail = index;
+        }
+        returned_head = index;
+        // Allocating threads that find the pool exhausted fall back to the new-delete resource, returned blocks must
+        // therefore not be held back while they do
+        const auto is_exhausted = NIL == static_cast<std::uint32_t>(head.load(std::memory_order_relaxed));
+        if (++returned_count == RETURN_BATCH_SIZE || is_exhausted)
+        {
+            this->publish_returned_blocks();
+        }
+    }
+
+    [[nodiscard]] bool owns(const void* p) const noexcept
+    {
+        const auto* block = static_cast<const Block*>(p);
+        return block >= blocks.get() && block < blocks.get() + block_count;
+    }
+
+  private:
+    struct Block
+    {
+        alignas(BLOCK_ALIGNMENT) std::byte storage[BLOCK_SIZE];
+    };
+
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+    static constexpr std::uint64_t make_head(std::uint64_t tag, std::uint32_t index) noexcept
+    {
+        return (tag << 32) | index;
+    }
+
+    Block* pop() noexcept
+    {
+        // Every update of the head increments its tag so that a concurrent pop that read a stale next index fails its
+        // compare-exchange
+        auto current = head.load(std::memory_order_acquire);
+        while (true)
+        {
+            const auto index = static_cast<std::uint32_t>(current);
+            if (index == NIL)
+            {
+                return nullptr;
+            }
+            const auto next = next_indices[index].load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(current, make_head((current >> 32) + 1, next), std::memory_order_acquire,
+                                           std::memory_order_acquire))
+            {
+                return &blocks[index];
+            }
+        }
+    }
+
+    void publish_returned_blocks() noexcept
+    {
+        auto current = head.load(std::memory_order_relaxed);
+        do
+        {
+            next_indices[returned_tail].store(static_cast<std::uint32_t>(current), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(current, make_head((current >> 32) + 1, returned_head),
+                                             std::memory_order_release, std::memory_order_relaxed));
+        returned_head = NIL;
+        returned_count = 0;
+    }
+
+    std::atomic<std::uint64_t> head{NIL};
+    std::unique_ptr<Block[]> blocks;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> next_indices;
+    std::size_t block_count{};
+    std::uint32_t returned_head{NIL};
+    std::uint32_t returned_tail{NIL};
+    std::size_t returned_count{};
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_REMOTEMEMORYPOOL_HPP
@@ -15,18 +15,25 @@
 #ifndef AGRPC_DETAIL_REPEATEDLYREQUEST_HPP
 #define AGRPC_DETAIL_REPEATEDLYREQUEST_HPP
 
+#include "agrpc/detail/admissionControl.hpp"
 #include "agrpc/detail/asioForward.hpp"
 #include "agrpc/detail/config.hpp"
 #include "agrpc/detail/queryGrpcContext.hpp"
 #include "agrpc/detail/rpcContext.hpp"
+#include "agrpc/detail/rpcContextPool.hpp"
 #include "agrpc/detail/utility.hpp"
 #include "agrpc/detail/workTrackingCompletionHandler.hpp"
 #include "agrpc/repeatedlyRequestContext.hpp"
+#include "agrpc/repeatedlyRequestOptions.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
 
 #ifdef AGRPC_ASIO_HAS_CO_AWAIT
-#include "agrpc/bindAllocator.hpp"
-#include "agrpc/detail/oneShotAllocator.hpp"
-#include "agrpc/rpc.hpp"
+#include <exception>
+#include <optional>
 #endif
 
 AGRPC_NAMESPACE_BEGIN()
@@ -42,6 +49,12 @@ struct RepeatedlyRequestContextAccess
     }
 };
 
+// Keeps the overloads of repeatedly_request without options from binding an options object as the request handler. The
+// arena options are only forward declared unless agrpc/repeatedlyRequestArenaOptions.hpp has been included.
+template <class T>
+inline constexpr bool IS_REPEATEDLY_REQUEST_OPTIONS =
+    std::is_base_of_v<agrpc::RepeatedlyRequestOptions, detail::RemoveCvrefT<T>>;
+
 #if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
 
 #ifdef AGRPC_ASIO_HAS_CANCELLATION_SLOT
@@ -155,6 +168,7 @@ class RepeatedlyRequestOperation
         auto next_rpc_context = this->allocate_rpc_context();
         auto* cq = local_grpc_context.get_server_completion_queue();
         local_grpc_context.work_started();
+        GrpcBase::set_operation_type(agrpc::OperationType::REQUEST);
         detail::initiate_request_from_rpc_context(this->rpc(), this->service(), *next_rpc_context, cq, this);
         next_rpc_context.release();
         return true;
@@ -207,6 +221,328 @@ class RepeatedlyRequestOperation
     RPCContext* rpc_context;
 };
 
+// Hands the RPC context to a request handler that takes an agrpc::RepeatedlyRequestContext
+struct RepeatedlyRequestCallbackInvoker
+{
+    template <class RequestHandler, class RPCContext>
+    using RPCContextT = RPCContext;
+
+    template <class RequestHandler, class Executor, class RPCContextPointer>
+    static void invoke(RequestHandler& request_handler, const Executor&, RPCContextPointer&& rpc_context)
+    {
+        request_handler(detail::RepeatedlyRequestContextAccess::create(std::move(rpc_context)));
+    }
+};
+
+// Options is agrpc::RepeatedlyRequestOptions or agrpc::RepeatedlyRequestArenaOptions, Invoker is
+// detail::RepeatedlyRequestCallbackInvoker or detail::RepeatedlyRequestAwaitableInvoker
+template <class RequestHandler, class RPC, class Service, class CompletionHandler, bool IsStoppable, class Options,
+          class Invoker>
+class RepeatedlyRequestWithOptionsOperation
+    : public detail::TypeErasedNoArgOperation,
+      public detail::RepeatedlyRequestOperationBase<RequestHandler, RPC, Service, CompletionHandler, IsStoppable>
+{
+  private:
+    using NoArgBase = detail::TypeErasedNoArgOperation;
+    using Base = detail::RepeatedlyRequestOperationBase<RequestHandler, RPC, Service, CompletionHandler, IsStoppable>;
+    using RPCContext =
+        typename Invoker::template RPCContextT<RequestHandler, detail::RPCContextForOptionsT<Options, RPC>>;
+    using Allocator = detail::RemoveCvrefT<decltype(std::declval<Base&>().get_allocator())>;
+    using RPCContextPool = detail::RPCContextPool<RPCContext, Allocator>;
+    using RPCContextAllocator = detail::RPCContextPoolAllocator<RPCContext, RPCContextPool>;
+
+    static constexpr auto ON_STOP_COMPLETE =
+        &detail::default_do_complete<RepeatedlyRequestWithOptionsOperation, detail::TypeErasedNoArgOperation>;
+
+    // One outstanding request
+    struct Slot : detail::TypeErasedGrpcTagOperation
+    {
+        Slot() noexcept
+            : detail::TypeErasedGrpcTagOperation(&RepeatedlyRequestWithOptionsOperation::on_request_complete)
+        {
+        }
+
+        RepeatedlyRequestWithOptionsOperation* self{};
+        RPCContext* rpc_context{};
+        Slot* next_parked{};
+        bool is_rejecting{};
+    };
+
+    // Submitted to the GrpcContext when an in-flight request handler has finished while slots are parked
+    struct ResumeOperation : detail::TypeErasedNoArgOperation
+    {
+        explicit ResumeOperation(RepeatedlyRequestWithOptionsOperation& self) noexcept
+            : detail::TypeErasedNoArgOperation(&RepeatedlyRequestWithOptionsOperation::on_resume), self(self)
+        {
+        }
+
+        RepeatedlyRequestWithOptionsOperation& self;
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+  public:
+    template <class Ch, class Rh>
+    RepeatedlyRequestWithOptionsOperation(Rh&& request_handler, RPC rpc, Service& service, Ch&& completion_handler,
+                                          const Options& options)
+        : NoArgBase(ON_STOP_COMPLETE),
+          Base(std::forward<Rh>(request_handler), rpc, service, std::forward<Ch>(completion_handler)),
+          admission_control(options.admission_policy),
+          max_in_flight(options.max_in_flight_handlers),
+          slot_count((std::max)(std::size_t{1}, options.outstanding_requests)),
+          resume_operation(*this)
+    {
+        rpc_context_pool = RPCContextPool::create(options.max_recycled_rpc_contexts, this->get_allocator());
+        rpc_context_pool->set_release_listener(&RepeatedlyRequestWithOptionsOperation::on_release);
+        SlotAllocator slot_allocator{this->get_allocator()};
+        AGRPC_TRY { slots = std::allocator_traits<SlotAllocator>::allocate(slot_allocator, slot_count); }
+        AGRPC_CATCH(...)
+        {
+            rpc_context_pool->remove_ref();
+            AGRPC_RETHROW();
+        }
+        for (std::size_t i{}; i < slot_count; ++i)
+        {
+            ::new (static_cast<void*>(slots + i)) Slot{};
+            slots[i].self = this;
+        }
+    }
+
+    RepeatedlyRequestWithOptionsOperation(const RepeatedlyRequestWithOptionsOperation&) = delete;
+    RepeatedlyRequestWithOptionsOperation(RepeatedlyRequestWithOptionsOperation&&) = delete;
+    RepeatedlyRequestWithOptionsOperation& operator=(const RepeatedlyRequestWithOptionsOperation&) = delete;
+    RepeatedlyRequestWithOptionsOperation& operator=(RepeatedlyRequestWithOptionsOperation&&) = delete;
+
+    ~RepeatedlyRequestWithOptionsOperation() noexcept
+    {
+        SlotAllocator slot_allocator{this->get_allocator()};
+        std::allocator_traits<SlotAllocator>::deallocate(slot_allocator, slots, slot_count);
+        rpc_context_pool->remove_ref();
+    }
+
+    // Returns false if not a single request could be initiated
+    bool initiate_repeatedly_request()
+    {
+        for (std::size_t i{}; i < slot_count; ++i)
+        {
+            if (this->initiate_request(slots[i]))
+            {
+                ++active_slots;
+            }
+        }
+        return active_slots != 0;
+    }
+
+  private:
+    bool initiate_request(Slot& slot)
+    {
+        if AGRPC_UNLIKELY (this->is_stopped())
+        {
+            return false;
+        }
+        auto& local_grpc_context = this->grpc_context();
+        slot.rpc_context = rpc_context_pool->acquire();
+        detail::ScopeGuard guard{[&]
+                                 {
+                                     rpc_context_pool->release_unused(slot.rpc_context);
+                                 }};
+        auto* cq = local_grpc_context.get_server_completion_queue();
+        local_grpc_context.work_started();
+        slot.set_operation_type(agrpc::OperationType::REQUEST);
+        detail::initiate_request_from_rpc_context(this->rpc(), this->service(), *slot.rpc_context, cq, &slot);
+        guard.release();
+        return true;
+    }
+
+    // Finish the RPC with RESOURCE_EXHAUSTED. The slot is re-armed once that has completed.
+    void reject(Slot& slot)
+    {
+        auto& local_grpc_context = this->grpc_context();
+        local_grpc_context.work_started();
+        slot.is_rejecting = true;
+        slot.set_operation_type(agrpc::OperationType::FINISH_WITH_ERROR);
+        detail::finish_with_error(slot.rpc_context->responder(),
+                                  grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED, "Server is overloaded"}, &slot);
+    }
+
+    [[nodiscard]] bool is_at_in_flight_limit() const noexcept
+    {
+        return max_in_flight != 0 && rpc_context_pool->in_flight() >= max_in_flight;
+    }
+
+    // Re-arm the slot, park it if too many request handlers are in flight or retire it if repeatedly_request has been
+    // stopped
+    void repeat(Slot& slot)
+    {
+        if AGRPC_UNLIKELY (this->is_at_in_flight_limit())
+        {
+            slot.next_parked = parked_slots;
+            parked_slots = &slot;
+            this->listen_for_release();
+            return;
+        }
+        if AGRPC_UNLIKELY (!this->initiate_request(slot))
+        {
+            this->retire_slot();
+        }
+    }
+
+    void listen_for_release()
+    {
+        if (is_listening)
+        {
+            return;
+        }
+        is_listening = true;
+        rpc_context_pool->listen_for_release(this);
+        // A request handler might have finished before the listener was armed
+        if (!this->is_at_in_flight_limit() && rpc_context_pool->stop_listening_for_release())
+        {
+            is_listening = false;
+            this->resume_parked_slots();
+        }
+    }
+
+    void resume_parked_slots()
+    {
+        while (parked_slots != nullptr && (this->is_stopped() || !this->is_at_in_flight_limit()))
+        {
+            auto& slot = *parked_slots;
+            parked_slots = slot.next_parked;
+            if (!this->initiate_request(slot))
+            {
+                this->retire_slot();
+            }
+        }
+        if (parked_slots != nullptr)
+        {
+            this->listen_for_release();
+        }
+    }
+
+    void retire_slot(detail::InvokeHandler invoke_handler = detail::InvokeHandler::YES)
+    {
+        if (0 == --active_slots)
+        {
+            this->complete(invoke_handler);
+        }
+    }
+
+    void complete(detail::InvokeHandler invoke_handler)
+    {
+        if (is_listening && !rpc_context_pool->stop_listening_for_release())
+        {
+            // The resume operation has already been submitted and refers to this operation
+            is_completion_deferred = true;
+            return;
+        }
+        is_listening = false;
+        if (detail::InvokeHandler::YES == invoke_handler)
+        {
+            detail::GrpcContextImplementation::add_local_operation(this->grpc_context(), this);
+        }
+        else
+        {
+            detail::WorkFinishedOnExit on_exit{this->grpc_context()};
+            ON_STOP_COMPLETE(this, invoke_handler, {});
+        }
+    }
+
+    static void on_request_complete(detail::TypeErasedGrpcTagOperation* op, detail::InvokeHandler invoke_handler,
+                                    bool ok, detail::GrpcContextLocalAllocator)
+    {
+        auto& slot = *static_cast<Slot*>(op);
+        auto* self = slot.self;
+        auto* pool = self->rpc_context_pool;
+        if AGRPC_UNLIKELY (slot.is_rejecting)
+        {
+            slot.is_rejecting = false;
+            pool->release_unused(slot.rpc_context);
+            if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+            {
+                self->repeat(slot);
+            }
+            else
+            {
+                self->retire_slot(invoke_handler);
+            }
+            return;
+        }
+        if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler && ok)
+        {
+            if AGRPC_UNLIKELY (self->admission_control.is_enabled() &&
+                               !self->admission_control.try_admit(self->grpc_context(), pool->in_flight()))
+            {
+                self->reject(slot);
+                return;
+            }
+            pool->add_in_flight();
+            detail::AllocatedPointer ptr{slot.rpc_context, RPCContextAllocator{pool}};
+            self->repeat(slot);
+            Invoker::invoke(self->request_handler(), self->get_executor(), std::move(ptr));
+            return;
+        }
+        pool->release_unused(slot.rpc_context);
+        self->retire_slot(invoke_handler);
+    }
+
+    static void on_release(void* target) noexcept
+    {
+        auto* self = static_cast<RepeatedlyRequestWithOptionsOperation*>(target);
+        auto& grpc_context = self->grpc_context();
+        grpc_context.work_started();
+        detail::GrpcContextImplementation::add_operation(grpc_context, &self->resume_operation);
+    }
+
+    static void on_resume(detail::TypeErasedNoArgOperation* op, detail::InvokeHandler invoke_handler,
+                          detail::GrpcContextLocalAllocator)
+    {
+        auto& self = static_cast<ResumeOperation*>(op)->self;
+        self.is_listening = false;
+        if AGRPC_UNLIKELY (self.is_completion_deferred)
+        {
+            self.complete(invoke_handler);
+        }
+        else if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+        {
+            self.resume_parked_slots();
+        }
+        else
+        {
+            // The GrpcContext is being destructed, parked slots will never be re-armed
+            std::size_t parked_count{};
+            for (; self.parked_slots != nullptr; self.parked_slots = self.parked_slots->next_parked)
+            {
+                ++parked_count;
+            }
+            self.active_slots -= parked_count;
+            if (parked_count != 0 && 0 == self.active_slots)
+            {
+                self.complete(invoke_handler);
+            }
+        }
+    }
+
+    RPCContextPool* rpc_context_pool;
+    detail::AdmissionControl admission_control;
+    Slot* slots{};
+    Slot* parked_slots{};
+    std::size_t active_slots{};
+    std::size_t max_in_flight;
+    std::size_t slot_count;
+    ResumeOperation resume_operation;
+    bool is_listening{};
+    bool is_completion_deferred{};
+};
+
+template <class Options, class Invoker>
+struct RepeatedlyRequestOperationWithOptions
+{
+    template <class RequestHandler, class RPC, class Service, class CompletionHandler, bool IsStoppable>
+    using Type = detail::RepeatedlyRequestWithOptionsOperation<RequestHandler, RPC, Service, CompletionHandler,
+                                                               IsStoppable, Options, Invoker>;
+};
+
 template <class Operation>
 void initiate_repeatedly_request(agrpc::GrpcContext& grpc_context, Operation& operation)
 {
@@ -219,9 +555,9 @@ void initiate_repeatedly_request(agrpc::GrpcContext& grpc_context, Operation& op
 template <template <class, class, class, class, bool> class Operation>
 struct BasicRepeatedlyRequestInitiator
 {
-    template <class RequestHandler, class RPC, class Service, class CompletionHandler>
+    template <class RequestHandler, class RPC, class Service, class CompletionHandler, class... Args>
     void operator()(CompletionHandler&& completion_handler, RequestHandler&& request_handler, RPC rpc,
-                    Service& service) const
+                    Service& service, Args&&... args) const
     {
         using TrackingCompletionHandler = detail::WorkTrackingCompletionHandler<CompletionHandler>;
         using DecayedRequestHandler = std::decay_t<RequestHandler>;
@@ -236,7 +572,7 @@ struct BasicRepeatedlyRequestInitiator
             auto operation =
                 detail::allocate<Operation<DecayedRequestHandler, RPC, Service, TrackingCompletionHandler, true>>(
                     allocator, std::forward<RequestHandler>(request_handler), rpc, service,
-                    std::forward<CompletionHandler>(completion_handler));
+                    std::forward<CompletionHandler>(completion_handler), std::forward<Args>(args)...);
             cancellation_slot.template emplace<detail::RepeatedlyRequestStopFunction>(operation->stop_context());
             detail::initiate_repeatedly_request(grpc_context, *operation);
             operation.release();
@@ -247,7 +583,7 @@ struct BasicRepeatedlyRequestInitiator
             auto operation =
                 detail::allocate<Operation<DecayedRequestHandler, RPC, Service, TrackingCompletionHandler, false>>(
                     allocator, std::forward<RequestHandler>(request_handler), rpc, service,
-                    std::forward<CompletionHandler>(completion_handler));
+                    std::forward<CompletionHandler>(completion_handler), std::forward<Args>(args)...);
             detail::initiate_repeatedly_request(grpc_context, *operation);
             operation.release();
         }
@@ -255,6 +591,10 @@ struct BasicRepeatedlyRequestInitiator
     }
 };
 
+template <class Options>
+using RepeatedlyRequestWithOptionsInitiator = detail::BasicRepeatedlyRequestInitiator<
+    detail::RepeatedlyRequestOperationWithOptions<Options, detail::RepeatedlyRequestCallbackInvoker>::template Type>;
+
 using RepeatedlyRequestInitiator = detail::BasicRepeatedlyRequestInitiator<detail::RepeatedlyRequestOperation>;
 
 #ifdef AGRPC_ASIO_HAS_CO_AWAIT
@@ -275,11 +615,15 @@ inline constexpr bool INVOKE_RESULT_IS_CO_SPAWNABLE<
     std::enable_if_t<detail::IS_CO_SPAWNABLE<detail::SchedulerT<Function>, std::invoke_result_t<Function, Args...>>>> =
     true;
 
-struct RethrowFirstArg
+// Keeps the RPC context of an awaitable request handler alive until the awaitable has completed
+template <class RPCContextPointer>
+struct RepeatedlyRequestAwaitableCompletionHandler
 {
-    template <class... Args>
-    void operator()(std::exception_ptr ep, Args&&...) const
+    RPCContextPointer rpc_context;
+
+    void operator()(std::exception_ptr ep)
     {
+        rpc_context.reset();
         if AGRPC_UNLIKELY (ep)
         {
             std::rethrow_exception(ep);
@@ -287,147 +631,48 @@ struct RethrowFirstArg
     }
 };
 
-template <class CompletionToken, class Signature, class = void>
-struct CompletionHandlerType
-{
-    using Type = typename asio::async_result<CompletionToken, Signature>::completion_handler_type;
-};
-
-template <class CompletionToken, class Signature>
-struct CompletionHandlerType<CompletionToken, Signature,
-                             std::void_t<typename asio::async_result<CompletionToken, Signature>::handler_type>>
-{
-    using Type = typename asio::async_result<CompletionToken, Signature>::handler_type;
-};
-
-template <class CompletionToken, class Signature>
-using CompletionHandlerTypeT = typename CompletionHandlerType<CompletionToken, Signature>::Type;
-
-template <std::size_t BufferSize>
-class BufferOperation : public detail::TypeErasedNoArgOperation
+// The request handler is stored alongside the RPC context because the awaitable that it returns may refer to it, e.g.
+// to the captures of a lambda, while the repeatedly_request operation might already be destructed.
+template <class RequestHandler, class Base>
+class AwaitableRPCContext : public Base
 {
   public:
-    BufferOperation() noexcept : detail::TypeErasedNoArgOperation(&do_complete) {}
-
-    auto one_shot_allocator() noexcept { return detail::OneShotAllocator<std::byte, BufferSize>{&this->buffer}; }
-
-  private:
-    static void do_complete(detail::TypeErasedNoArgOperation* op, detail::InvokeHandler,
-                            detail::GrpcContextLocalAllocator) noexcept
+    template <class Rh>
+    decltype(auto) invoke(Rh&& request_handler)
     {
-        detail::deallocate(std::allocator<BufferOperation>{}, static_cast<BufferOperation*>(op));
+        return std::apply(this->handler.emplace(std::forward<Rh>(request_handler)), this->args());
     }
 
-    std::aligned_storage_t<BufferSize> buffer;
-};
-
-template <std::size_t BufferSize>
-auto create_allocated_buffer_operation()
-{
-    using Op = detail::BufferOperation<BufferSize>;
-    auto ptr = detail::allocate<Op>(std::allocator<Op>{});
-    auto* buffer_operation_ptr = ptr.get();
-    ptr.release();
-    return buffer_operation_ptr;
-}
-
-template <class RPC, class Service, class Request, class Responder, class CompletionToken>
-auto initiate_request_from_rpc_context(detail::ServerMultiArgRequest<RPC, Request, Responder> rpc, Service& service,
-                                       detail::MultiArgRPCContext<Request, Responder>& rpc_context,
-                                       CompletionToken&& token)
-{
-    return agrpc::request(rpc, service, rpc_context.server_context(), rpc_context.request(), rpc_context.responder(),
-                          std::forward<CompletionToken>(token));
-}
-
-template <class RPC, class Service, class Responder, class CompletionToken>
-auto initiate_request_from_rpc_context(detail::ServerSingleArgRequest<RPC, Responder> rpc, Service& service,
-                                       detail::SingleArgRPCContext<Responder>& rpc_context, CompletionToken&& token)
-{
-    return agrpc::request(rpc, service, rpc_context.server_context(), rpc_context.responder(),
-                          std::forward<CompletionToken>(token));
-}
-
-template <class RequestHandler, class RPC, class Service, class CompletionHandler, bool IsStoppable>
-class RepeatedlyRequestAwaitableOperation
-    : public detail::TypeErasedNoArgOperation,
-      public detail::RepeatedlyRequestOperationBase<RequestHandler, RPC, Service, CompletionHandler, IsStoppable>
-{
-  private:
-    using Base = detail::RepeatedlyRequestOperationBase<RequestHandler, RPC, Service, CompletionHandler, IsStoppable>;
-    using NoArgBase = detail::TypeErasedNoArgOperation;
-    using RPCContext = detail::RPCContextForRPCT<RPC>;
-    using Awaitable = detail::InvokeResultFromSignatureT<RequestHandler&, typename RPCContext::Signature>;
-    using UseAwaitable = asio::use_awaitable_t<typename Awaitable::executor_type>;
-
-    static constexpr auto ON_STOP_COMPLETE =
-        &detail::default_do_complete<RepeatedlyRequestAwaitableOperation, detail::TypeErasedNoArgOperation>;
-    static constexpr auto BUFFER_SIZE =
-        sizeof(detail::CompletionHandlerTypeT<UseAwaitable, void()>) + 3 * sizeof(void*);
-
-    using BufferOp = detail::BufferOperation<BUFFER_SIZE>;
-
-  public:
-    template <class Ch, class Rh>
-    RepeatedlyRequestAwaitableOperation(Rh&& request_handler, RPC rpc, Service& service, Ch&& completion_handler)
-        : NoArgBase(ON_STOP_COMPLETE),
-          detail::RepeatedlyRequestOperationBase<RequestHandler, RPC, Service, CompletionHandler, IsStoppable>(
-              std::forward<Rh>(request_handler), rpc, service, std::forward<Ch>(completion_handler)),
-          buffer_operation(detail::create_allocated_buffer_operation<BUFFER_SIZE>())
+    void recycle()
     {
-        // Count buffer_operation
-        this->grpc_context().work_started();
+        this->handler.reset();
+        Base::recycle();
     }
 
-    ~RepeatedlyRequestAwaitableOperation()
-    {
-        detail::GrpcContextImplementation::add_local_operation(this->grpc_context(), this->buffer_operation);
-    }
+  private:
+    std::optional<RequestHandler> handler;
+};
 
-    bool initiate_repeatedly_request()
-    {
-        if AGRPC_UNLIKELY (this->is_stopped())
-        {
-            return false;
-        }
-        asio::co_spawn(this->get_executor(), this->perform_request_and_repeat(), detail::RethrowFirstArg{});
-        return true;
-    }
+// Co_spawns the awaitable that is returned by the request handler. Unlike co_awaiting the request from within a
+// coroutine, this does not require a coroutine frame to be kept alive while waiting for the next RPC.
+struct RepeatedlyRequestAwaitableInvoker
+{
+    template <class RequestHandler, class RPCContext>
+    using RPCContextT = detail::AwaitableRPCContext<RequestHandler, RPCContext>;
 
-  private:
-    Awaitable perform_request_and_repeat()
+    template <class RequestHandler, class Executor, class RPCContextPointer>
+    static void invoke(RequestHandler& request_handler, const Executor& executor, RPCContextPointer&& rpc_context)
     {
-        auto& local_grpc_context = this->grpc_context();
-        RPCContext rpc_context;
-        detail::ScopeGuard guard{[&]
-                                 {
-                                     detail::WorkFinishedOnExit on_exit{local_grpc_context};
-                                     ON_STOP_COMPLETE(this, detail::InvokeHandler::NO, {});
-                                 }};
-        const auto ok = co_await detail::initiate_request_from_rpc_context(
-            this->rpc(), this->service(), rpc_context,
-            agrpc::bind_allocator(this->buffer_operation->one_shot_allocator(), UseAwaitable{}));
-        guard.release();
-        if AGRPC_LIKELY (ok)
-        {
-            auto local_request_handler = this->request_handler();
-            if AGRPC_UNLIKELY (!this->initiate_repeatedly_request())
-            {
-                detail::GrpcContextImplementation::add_local_operation(local_grpc_context, this);
-            }
-            co_await std::apply(std::move(local_request_handler), rpc_context.args());
-        }
-        else
-        {
-            detail::GrpcContextImplementation::add_local_operation(local_grpc_context, this);
-        }
+        auto awaitable = rpc_context->invoke(request_handler);
+        asio::co_spawn(executor, std::move(awaitable),
+                       detail::RepeatedlyRequestAwaitableCompletionHandler<detail::RemoveCvrefT<RPCContextPointer>>{
+                           std::move(rpc_context)});
     }
-
-    BufferOp* buffer_operation;
 };
 
-using RepeatedlyRequestAwaitableInitiator =
-    detail::BasicRepeatedlyRequestInitiator<detail::RepeatedlyRequestAwaitableOperation>;
+template <class Options>
+using RepeatedlyRequestAwaitableInitiator = detail::BasicRepeatedlyRequestInitiator<
+    detail::RepeatedlyRequestOperationWithOptions<Options, detail::RepeatedlyRequestAwaitableInvoker>::template Type>;
 #endif
 #endif
 }
@@ -222,6 +222,7 @@ class RepeatedlyRequestSender : public detail::SenderOf<>
             auto ptr = this->allocate_request_handler_operation();
             auto* cq = local_grpc_context.get_server_completion_queue();
             local_grpc_context.work_started();
+            GrpcBase::set_operation_type(agrpc::OperationType::REQUEST);
             detail::initiate_request_from_rpc_context(this->rpc(), this->service(), ptr->rpc_context(), cq, this);
             ptr.release();
             return true;
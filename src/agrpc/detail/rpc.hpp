@@ -17,10 +17,13 @@
 
 #include "agrpc/detail/asioForward.hpp"
 #include "agrpc/detail/config.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
 
 #include <grpcpp/client_context.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/async_stream.h>
 
 #include <memory>
 
@@ -55,11 +58,43 @@ template <class RPC, class Responder>
 using ServerSingleArgRequest = void (RPC::*)(grpc::ServerContext*, Responder*, grpc::CompletionQueue*,
                                              grpc::ServerCompletionQueue*, void*);
 
+template <class Responder>
+struct StreamWriterMessage;
+
+template <class Response>
+struct StreamWriterMessage<grpc::ServerAsyncWriter<Response>>
+{
+    using Type = Response;
+};
+
+template <class Response, class Request>
+struct StreamWriterMessage<grpc::ServerAsyncReaderWriter<Response, Request>>
+{
+    using Type = Response;
+};
+
+template <class Request>
+struct StreamWriterMessage<grpc::ClientAsyncWriter<Request>>
+{
+    using Type = Request;
+};
+
+template <class Request, class Response>
+struct StreamWriterMessage<grpc::ClientAsyncReaderWriter<Request, Response>>
+{
+    using Type = Request;
+};
+
+template <class Responder>
+using StreamWriterMessageT = typename detail::StreamWriterMessage<Responder>::Type;
+
 template <class Message, class Responder>
 struct BaseAsyncReaderInitFunctions
 {
     struct Read
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::READ;
+
         Responder& responder;
         Message& message;
 
@@ -72,6 +107,8 @@ struct BaseAsyncWriterInitFunctions
 {
     struct Write
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITE;
+
         Responder& responder;
         const Message& message;
 
@@ -80,6 +117,8 @@ struct BaseAsyncWriterInitFunctions
 
     struct WriteWithOptions
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITE;
+
         Responder& responder;
         const Message& message;
         grpc::WriteOptions options;
@@ -89,6 +128,8 @@ struct BaseAsyncWriterInitFunctions
 
     struct WriteLast
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITE_LAST;
+
         Responder& responder;
         const Message& message;
         grpc::WriteOptions options;
@@ -102,6 +143,8 @@ struct BaseClientAsyncStreamingInitFunctions
 {
     struct WritesDone
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITES_DONE;
+
         Responder& responder;
 
         void operator()(const agrpc::GrpcContext&, void* tag) { responder.WritesDone(tag); }
@@ -109,6 +152,8 @@ struct BaseClientAsyncStreamingInitFunctions
 
     struct Finish
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH;
+
         Responder& responder;
         grpc::Status& status;
 
@@ -142,6 +187,8 @@ struct ClientAsyncResponseReaderInitFunctions
 {
     struct Finish
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH;
+
         grpc::ClientAsyncResponseReader<Response>& responder;
         Response& response;
         grpc::Status& status;
@@ -153,6 +200,8 @@ struct ClientAsyncResponseReaderInitFunctions
 template <class Responder>
 struct ReadInitialMetadataInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::READ_INITIAL_METADATA;
+
     Responder& responder;
 
     void operator()(const agrpc::GrpcContext&, void* tag) { responder.ReadInitialMetadata(tag); }
@@ -163,6 +212,8 @@ struct BaseServerAsyncReaderInitFunctions
 {
     struct Finish
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH;
+
         Responder& responder;
         const Message& message;
         const grpc::Status& status;
@@ -172,6 +223,8 @@ struct BaseServerAsyncReaderInitFunctions
 
     struct FinishWithError
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH_WITH_ERROR;
+
         Responder& responder;
         const grpc::Status& status;
 
@@ -184,6 +237,8 @@ struct BaseServerAsyncWriterInitFunctions
 {
     struct WriteAndFinish
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITE_AND_FINISH;
+
         Responder& responder;
         const Message& message;
         grpc::WriteOptions options;
@@ -197,6 +252,8 @@ struct BaseServerAsyncWriterInitFunctions
 
     struct Finish
     {
+        static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH;
+
         Responder& responder;
         const grpc::Status& status;
 
@@ -235,6 +292,8 @@ struct ServerAsyncResponseWriterInitFunctions
 template <class Responder>
 struct SendInitialMetadataInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::SEND_INITIAL_METADATA;
+
     Responder& responder;
 
     void operator()(const agrpc::GrpcContext&, void* tag) { responder.SendInitialMetadata(tag); }
@@ -243,6 +302,8 @@ struct SendInitialMetadataInitFunction
 template <class Stub, class Request, class Response>
 struct ClientServerStreamingRequestInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientServerStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -258,6 +319,8 @@ struct ClientServerStreamingRequestInitFunction
 template <class Stub, class Request, class Response>
 struct ClientServerStreamingRequestConvenienceInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientServerStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -274,6 +337,8 @@ struct ClientServerStreamingRequestConvenienceInitFunction
 template <class Stub, class Request, class Response>
 struct ClientClientStreamingRequestInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientClientStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -289,6 +354,8 @@ struct ClientClientStreamingRequestInitFunction
 template <class Stub, class Request, class Response>
 struct ClientClientStreamingRequestConvenienceInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientClientStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -305,6 +372,8 @@ struct ClientClientStreamingRequestConvenienceInitFunction
 template <class Stub, class Request, class Response>
 struct ClientBidirectionalStreamingRequestInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientBidirectionalStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -319,6 +388,8 @@ struct ClientBidirectionalStreamingRequestInitFunction
 template <class Stub, class Request, class Response>
 struct ClientBidirectionalStreamingRequestConvenienceInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ClientBidirectionalStreamingRequest<Stub, Request, Response> rpc;
     Stub& stub;
     grpc::ClientContext& client_context;
@@ -333,6 +404,8 @@ struct ClientBidirectionalStreamingRequestConvenienceInitFunction
 template <class RPC, class Service, class Request, class Responder>
 struct ServerMultiArgRequestInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ServerMultiArgRequest<RPC, Request, Responder> rpc;
     Service& service;
     grpc::ServerContext& server_context;
@@ -349,6 +422,8 @@ struct ServerMultiArgRequestInitFunction
 template <class RPC, class Service, class Responder>
 struct ServerSingleArgRequestInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::REQUEST;
+
     detail::ServerSingleArgRequest<RPC, Responder> rpc;
     Service& service;
     grpc::ServerContext& server_context;
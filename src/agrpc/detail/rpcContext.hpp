@@ -21,17 +21,68 @@
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_context.h>
 
+#include <new>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 AGRPC_NAMESPACE_BEGIN()
 
 namespace detail
 {
+template <class, class = void>
+inline constexpr bool HAS_CLEAR_MEMBER_FUNCTION = false;
+
+template <class T>
+inline constexpr bool HAS_CLEAR_MEMBER_FUNCTION<T, std::void_t<decltype(std::declval<T&>().Clear())>> = true;
+
+template <class Request>
+void clear_request(Request& request)
+{
+    if constexpr (detail::HAS_CLEAR_MEMBER_FUNCTION<Request>)
+    {
+        request.Clear();
+    }
+    else
+    {
+        request = Request{};
+    }
+}
+
+template <class, class = void>
+inline constexpr bool HAS_FINISH_WITH_ERROR_MEMBER_FUNCTION = false;
+
+template <class T>
+inline constexpr bool HAS_FINISH_WITH_ERROR_MEMBER_FUNCTION<
+    T, std::void_t<decltype(std::declval<T&>().FinishWithError(std::declval<const grpc::Status&>(), nullptr))>> = true;
+
+// Finish an RPC without sending a response message
+template <class Responder>
+void finish_with_error(Responder& responder, const grpc::Status& status, void* tag)
+{
+    if constexpr (detail::HAS_FINISH_WITH_ERROR_MEMBER_FUNCTION<Responder>)
+    {
+        responder.FinishWithError(status, tag);
+    }
+    else
+    {
+        responder.Finish(status, tag);
+    }
+}
+
 class RPCContextBase
 {
   public:
     constexpr auto& server_context() noexcept { return context; }
 
+  protected:
+    // A grpc::ServerContext must not be reused for another RPC
+    void reset_server_context()
+    {
+        context.~ServerContext();
+        ::new (static_cast<void*>(&context)) grpc::ServerContext{};
+    }
+
   private:
     grpc::ServerContext context{};
 };
@@ -53,6 +104,15 @@ class MultiArgRPCContext : public detail::RPCContextBase
 
     constexpr auto& responder() noexcept { return this->responder_; }
 
+    // Prepare this context for the next RPC while retaining the memory owned by the request message
+    void recycle()
+    {
+        this->responder_.~Responder();
+        this->reset_server_context();
+        ::new (static_cast<void*>(&this->responder_)) Responder{&this->server_context()};
+        detail::clear_request(this->request_);
+    }
+
   private:
     Request request_{};
     Responder responder_{&this->server_context()};
@@ -70,6 +130,13 @@ class SingleArgRPCContext : public detail::RPCContextBase
 
     constexpr auto& responder() noexcept { return this->responder_; }
 
+    void recycle()
+    {
+        this->responder_.~Responder();
+        this->reset_server_context();
+        ::new (static_cast<void*>(&this->responder_)) Responder{&this->server_context()};
+    }
+
   private:
     Responder responder_{&this->server_context()};
 };
@@ -92,18 +159,26 @@ struct RPCContextForRPC<detail::ServerSingleArgRequest<RPC, Responder>>
 template <class RPC>
 using RPCContextForRPCT = typename detail::RPCContextForRPC<detail::RemoveCvrefT<RPC>>::Type;
 
-template <class RPC, class Service, class Request, class Responder>
+// The RPC context that repeatedly_request creates for the given options, see agrpc/repeatedlyRequestArenaOptions.hpp
+template <class Options, class RPC>
+struct RPCContextForOptions
+{
+    using Type = detail::RPCContextForRPCT<RPC>;
+};
+
+template <class Options, class RPC>
+using RPCContextForOptionsT = typename detail::RPCContextForOptions<Options, RPC>::Type;
+
+template <class RPC, class Service, class Request, class Responder, class RPCContext>
 void initiate_request_from_rpc_context(detail::ServerMultiArgRequest<RPC, Request, Responder> rpc, Service& service,
-                                       detail::MultiArgRPCContext<Request, Responder>& rpc_context,
-                                       grpc::ServerCompletionQueue* cq, void* tag)
+                                       RPCContext& rpc_context, grpc::ServerCompletionQueue* cq, void* tag)
 {
     (service.*rpc)(&rpc_context.server_context(), &rpc_context.request(), &rpc_context.responder(), cq, cq, tag);
 }
 
-template <class RPC, class Service, class Responder>
+template <class RPC, class Service, class Responder, class RPCContext>
 void initiate_request_from_rpc_context(detail::ServerSingleArgRequest<RPC, Responder> rpc, Service& service,
-                                       detail::SingleArgRPCContext<Responder>& rpc_context,
-                                       grpc::ServerCompletionQueue* cq, void* tag)
+                                       RPCContext& rpc_context, grpc::ServerCompletionQueue* cq, void* tag)
 {
     (service.*rpc)(&rpc_context.server_context(), &rpc_context.responder(), cq, cq, tag);
 }
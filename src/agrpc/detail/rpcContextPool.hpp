@@ -0,0 +1,214 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_RPCCONTEXTPOOL_HPP
+#define AGRPC_DETAIL_RPCCONTEXTPOOL_HPP
+
+#include "agrpc/detail/allocate.hpp"
+#include "agrpc/detail/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+// Reference counted free-list of RPC contexts. Contexts are acquired by the thread that runs the repeatedly_request
+// operation and may be released from any thread. The pool is kept alive by the operation and by every acquired context.
+// It also counts the contexts that have been handed to the request handler and notifies a one-shot listener when one of
+// them is released.
+template <class RPCContext, class Allocator>
+class RPCContextPool
+{
+  private:
+    struct Node : RPCContext
+    {
+        Node* next{};
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using PoolAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<RPCContextPool>;
+
+  public:
+    RPCContextPool(std::size_t max_size, const Allocator& allocator) : max_size(max_size), allocator(allocator) {}
+
+    RPCContextPool(const RPCContextPool&) = delete;
+    RPCContextPool(RPCContextPool&&) = delete;
+    RPCContextPool& operator=(const RPCContextPool&) = delete;
+    RPCContextPool& operator=(RPCContextPool&&) = delete;
+
+    ~RPCContextPool() noexcept
+    {
+        RPCContextPool::destroy_nodes(local_nodes, allocator);
+        RPCContextPool::destroy_nodes(returned_nodes.load(std::memory_order_acquire), allocator);
+    }
+
+    static RPCContextPool* create(std::size_t max_size, const Allocator& allocator)
+    {
+        auto ptr = detail::allocate<RPCContextPool>(PoolAllocator{allocator}, max_size, allocator);
+        auto* pool = ptr.get();
+        ptr.release();
+        return pool;
+    }
+
+    RPCContext* acquire()
+    {
+        if (local_nodes == nullptr)
+        {
+            local_nodes = returned_nodes.exchange(nullptr, std::memory_order_acquire);
+        }
+        Node* node;
+        if (local_nodes != nullptr)
+        {
+            node = local_nodes;
+            local_nodes = node->next;
+            pooled_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            auto ptr = detail::allocate<Node>(NodeAllocator{allocator});
+            node = ptr.get();
+            ptr.release();
+        }
+        ref_count.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    using ReleaseListener = void (*)(void*) noexcept;
+
+    void add_in_flight() noexcept { in_flight_count.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept { return in_flight_count.load(std::memory_order_acquire); }
+
+    void set_release_listener(ReleaseListener listener) noexcept { release_listener = listener; }
+
+    // Arm the listener for the next release of an in-flight context
+    void listen_for_release(void* target) noexcept { release_listener_target.store(target, std::memory_order_release); }
+
+    // Returns true if the listener was still armed and has therefore not been and will not be invoked
+    [[nodiscard]] bool stop_listening_for_release() noexcept
+    {
+        return release_listener_target.exchange(nullptr, std::memory_order_acq_rel) != nullptr;
+    }
+
+    // Release a context that has been handed to the request handler
+    void release(RPCContext* rpc_context) noexcept
+    {
+        in_flight_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (auto* target = release_listener_target.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            release_listener(target);
+        }
+        this->release_unused(rpc_context);
+    }
+
+    // Release a context that has never been handed to the request handler
+    void release_unused(RPCContext* rpc_context) noexcept
+    {
+        auto* node = static_cast<Node*>(rpc_context);
+        if (pooled_count.fetch_add(1, std::memory_order_relaxed) < max_size)
+        {
+            node->recycle();
+            node->next = returned_nodes.load(std::memory_order_relaxed);
+            while (!returned_nodes.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                         std::memory_order_relaxed))
+            {
+            }
+        }
+        else
+        {
+            pooled_count.fetch_sub(1, std::memory_order_relaxed);
+            detail::deallocate(NodeAllocator{allocator}, node);
+        }
+        this->remove_ref();
+    }
+
+    void remove_ref() noexcept
+    {
+        if (1 == ref_count.fetch_sub(1, std::memory_order_acq_rel))
+        {
+            PoolAllocator pool_allocator{allocator};
+            detail::deallocate(pool_allocator, this);
+        }
+    }
+
+  private:
+    static void destroy_nodes(Node* node, const Allocator& allocator) noexcept
+    {
+        NodeAllocator node_allocator{allocator};
+        while (node != nullptr)
+        {
+            auto* next = node->next;
+            detail::deallocate(node_allocator, node);
+            node = next;
+        }
+    }
+
+    std::atomic_size_t ref_count{1};
+    std::atomic_size_t in_flight_count{};
+    std::atomic<void*> release_listener_target{};
+    ReleaseListener release_listener{};
+    std::atomic_size_t pooled_count{};
+    std::atomic<Node*> returned_nodes{};
+    Node* local_nodes{};
+    std::size_t max_size;
+    Allocator allocator;
+};
+
+// Allocator used by agrpc::RepeatedlyRequestContext to hand its RPC context back to the pool
+template <class T, class Pool>
+class RPCContextPoolAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit RPCContextPoolAllocator(Pool* pool) noexcept : pool(pool) {}
+
+    template <class U>
+    RPCContextPoolAllocator(const RPCContextPoolAllocator<U, Pool>& other) noexcept : pool(other.pool)
+    {
+    }
+
+    template <class U>
+    static void destroy(U*) noexcept
+    {
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { pool->release(p); }
+
+    template <class U>
+    friend bool operator==(const RPCContextPoolAllocator& lhs, const RPCContextPoolAllocator<U, Pool>& rhs) noexcept
+    {
+        return lhs.pool == rhs.pool;
+    }
+
+    template <class U>
+    friend bool operator!=(const RPCContextPoolAllocator& lhs, const RPCContextPoolAllocator<U, Pool>& rhs) noexcept
+    {
+        return lhs.pool != rhs.pool;
+    }
+
+  private:
+    template <class, class>
+    friend class RPCContextPoolAllocator;
+
+    Pool* pool;
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_RPCCONTEXTPOOL_HPP
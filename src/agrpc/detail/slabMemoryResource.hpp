@@ -0,0 +1,212 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_SLABMEMORYRESOURCE_HPP
+#define AGRPC_DETAIL_SLABMEMORYRESOURCE_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/memoryResource.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+// Memory resource with a fixed set of power-of-two size classes. Every size class keeps a free list of blocks that are
+// carved out of chunks obtained from the upstream resource. Chunks grow by a fixed number of blocks and are only
+// returned to the upstream resource on destruction. A size class never grows beyond MAX_BLOCKS_PER_SIZE_CLASS blocks,
+// once it is exhausted further requests are forwarded to the upstream resource until blocks are returned. Requests
+// that exceed the largest size class or that are over-aligned are always forwarded to the upstream resource, they are
+// not pooled. Not thread-safe.
+class SlabMemoryResource
+{
+  public:
+    static constexpr std::size_t SMALLEST_BLOCK_SIZE = 32;
+    static constexpr std::size_t SIZE_CLASS_COUNT = 6;
+    static constexpr std::size_t LARGEST_BLOCK_SIZE = SMALLEST_BLOCK_SIZE << (SIZE_CLASS_COUNT - 1);
+    static constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 16;
+    static constexpr std::size_t MAX_BLOCKS_PER_SIZE_CLASS = 4096;
+
+    explicit SlabMemoryResource(detail::pmr::memory_resource* upstream) noexcept : upstream(upstream) {}
+
+    SlabMemoryResource(const SlabMemoryResource&) = delete;
+    SlabMemoryResource(SlabMemoryResource&&) = delete;
+    SlabMemoryResource& operator=(const SlabMemoryResource&) = delete;
+    SlabMemoryResource& operator=(SlabMemoryResource&&) = delete;
+
+    ~SlabMemoryResource() noexcept
+    {
+        for (auto& size_class : size_classes)
+        {
+            while (size_class.chunks != nullptr)
+            {
+                auto* chunk = size_class.chunks;
+                size_class.chunks = chunk->next;
+                upstream->deallocate(chunk, chunk->size, BLOCK_ALIGNMENT);
+            }
+        }
+    }
+
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if AGRPC_UNLIKELY (!SlabMemoryResource::is_slab_allocation(bytes, alignment))
+        {
+            return upstream->allocate(bytes, alignment);
+        }
+        const auto index = SlabMemoryResource::size_class_index(bytes);
+        auto& size_class = size_classes[index];
+        if AGRPC_UNLIKELY (size_class.free_list == nullptr)
+        {
+            if AGRPC_UNLIKELY (size_class.total_blocks == MAX_BLOCKS_PER_SIZE_CLASS)
+            {
+                ++size_class.upstream_blocks;
+                return upstream->allocate(SMALLEST_BLOCK_SIZE << index, BLOCK_ALIGNMENT);
+            }
+            this->add_chunk(index, std::min(BLOCKS_PER_CHUNK, MAX_BLOCKS_PER_SIZE_CLASS - size_class.total_blocks));
+        }
+        auto* block = size_class.free_list;
+        size_class.free_list = block->next;
+        --size_class.free_blocks;
+        return block;
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if AGRPC_UNLIKELY (!SlabMemoryResource::is_slab_allocation(bytes, alignment))
+        {
+            upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+        const auto index = SlabMemoryResource::size_class_index(bytes);
+        auto& size_class = size_classes[index];
+        const auto block_size = SMALLEST_BLOCK_SIZE << index;
+        if AGRPC_UNLIKELY (size_class.upstream_blocks != 0 && !SlabMemoryResource::owns(size_class, p, block_size))
+        {
+            --size_class.upstream_blocks;
+            upstream->deallocate(p, block_size, BLOCK_ALIGNMENT);
+            return;
+        }
+        size_class.free_list = ::new (p) Block{size_class.free_list};
+        ++size_class.free_blocks;
+    }
+
+    // Ensure that at least `count` blocks of the size class that serves `bytes` are free, as far as
+    // MAX_BLOCKS_PER_SIZE_CLASS permits
+    void reserve(std::size_t bytes, std::size_t count)
+    {
+        if (!SlabMemoryResource::is_slab_allocation(bytes, 1))
+        {
+            return;
+        }
+        const auto index = SlabMemoryResource::size_class_index(bytes);
+        const auto& size_class = size_classes[index];
+        if (size_class.free_blocks < count)
+        {
+            const auto block_count = std::min(count - size_class.free_blocks,
+                                              MAX_BLOCKS_PER_SIZE_CLASS - size_class.total_blocks);
+            if (block_count != 0)
+            {
+                this->add_chunk(index, block_count);
+            }
+        }
+    }
+
+    [[nodiscard]] detail::pmr::memory_resource* upstream_resource() const noexcept { return upstream; }
+
+  private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct Chunk
+    {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    struct SizeClass
+    {
+        Block* free_list{};
+        Chunk* chunks{};
+        std::size_t free_blocks{};
+        std::size_t total_blocks{};
+
+        // Blocks that have been allocated from the upstream resource because this size class was exhausted
+        std::size_t upstream_blocks{};
+    };
+
+    static constexpr std::size_t CHUNK_HEADER_SIZE =
+        (sizeof(Chunk) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+
+    static constexpr bool is_slab_allocation(std::size_t bytes, std::size_t alignment) noexcept
+    {
+        return bytes <= LARGEST_BLOCK_SIZE && alignment <= BLOCK_ALIGNMENT;
+    }
+
+    static constexpr std::size_t size_class_index(std::size_t bytes) noexcept
+    {
+        std::size_t index{};
+        for (auto block_size = SMALLEST_BLOCK_SIZE; block_size < bytes; block_size *= 2)
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    // Only called while blocks of this size class are served by the upstream resource
+    static bool owns(const SizeClass& size_class, const void* p, std::size_t block_size) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        for (const auto* chunk = size_class.chunks; chunk != nullptr; chunk = chunk->next)
+        {
+            const auto begin = reinterpret_cast<std::uintptr_t>(chunk) + CHUNK_HEADER_SIZE;
+            const auto end = reinterpret_cast<std::uintptr_t>(chunk) + chunk->size;
+            if (address >= begin && address <= end - block_size)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void add_chunk(std::size_t index, std::size_t block_count)
+    {
+        const auto block_size = SMALLEST_BLOCK_SIZE << index;
+        const auto chunk_size = CHUNK_HEADER_SIZE + block_size * block_count;
+        auto* memory = static_cast<std::byte*>(upstream->allocate(chunk_size, BLOCK_ALIGNMENT));
+        auto& size_class = size_classes[index];
+        size_class.chunks = ::new (memory) Chunk{size_class.chunks, chunk_size};
+        for (auto offset = chunk_size; offset > CHUNK_HEADER_SIZE; offset -= block_size)
+        {
+            size_class.free_list = ::new (memory + offset - block_size) Block{size_class.free_list};
+        }
+        size_class.free_blocks += block_count;
+        size_class.total_blocks += block_count;
+    }
+
+    detail::pmr::memory_resource* upstream;
+    std::array<SizeClass, SIZE_CLASS_COUNT> size_classes{};
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_SLABMEMORYRESOURCE_HPP
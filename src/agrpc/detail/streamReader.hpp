@@ -0,0 +1,103 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_STREAMREADER_HPP
+#define AGRPC_DETAIL_STREAMREADER_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <grpcpp/support/async_stream.h>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+template <class Responder>
+struct StreamReaderMessage;
+
+template <class Response, class Request>
+struct StreamReaderMessage<grpc::ServerAsyncReader<Response, Request>>
+{
+    using Type = Request;
+};
+
+template <class Response, class Request>
+struct StreamReaderMessage<grpc::ServerAsyncReaderWriter<Response, Request>>
+{
+    using Type = Request;
+};
+
+template <class Response>
+struct StreamReaderMessage<grpc::ClientAsyncReader<Response>>
+{
+    using Type = Response;
+};
+
+template <class Request, class Response>
+struct StreamReaderMessage<grpc::ClientAsyncReaderWriter<Request, Response>>
+{
+    using Type = Response;
+};
+
+template <class Responder>
+using StreamReaderMessageT = typename detail::StreamReaderMessage<Responder>::Type;
+
+struct StreamReaderAccess
+{
+    template <class StreamReader>
+    static void initiate_next(StreamReader& reader, agrpc::GrpcContext& grpc_context, void* tag)
+    {
+        reader.initiate_next(grpc_context, static_cast<detail::TypeErasedGrpcTagOperation*>(tag));
+    }
+
+    template <class StreamReader>
+    static void initiate_drain(StreamReader& reader, agrpc::GrpcContext& grpc_context, void* tag)
+    {
+        reader.initiate_drain(grpc_context, static_cast<detail::TypeErasedGrpcTagOperation*>(tag));
+    }
+};
+
+template <class StreamReader>
+struct StreamReaderNextInitFunction
+{
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::READ;
+
+    StreamReader& reader;
+
+    void operator()(agrpc::GrpcContext& grpc_context, void* tag) const
+    {
+        detail::StreamReaderAccess::initiate_next(reader, grpc_context, tag);
+    }
+};
+
+template <class StreamReader>
+struct StreamReaderDrainInitFunction
+{
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::READ;
+
+    StreamReader& reader;
+
+    void operator()(agrpc::GrpcContext& grpc_context, void* tag) const
+    {
+        detail::StreamReaderAccess::initiate_drain(reader, grpc_context, tag);
+    }
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_STREAMREADER_HPP
@@ -20,6 +20,7 @@
 #include "agrpc/detail/grpcContext.hpp"
 #include "agrpc/detail/intrusiveQueueHook.hpp"
 #include "agrpc/detail/utility.hpp"
+#include "agrpc/operationType.hpp"
 
 AGRPC_NAMESPACE_BEGIN()
 
@@ -44,13 +45,30 @@ class TypeErasedOperation
         this->on_complete(this, invoke_handler, detail::forward_as<Signature>(args)...);
     }
 
+#ifdef AGRPC_ENABLE_OPERATION_TYPE_TRACKING
+    [[nodiscard]] agrpc::OperationType operation_type() const noexcept { return type; }
+
+    void set_operation_type(agrpc::OperationType operation_type) noexcept { type = operation_type; }
+#else
+    [[nodiscard]] static constexpr agrpc::OperationType operation_type() noexcept { return DEFAULT_OPERATION_TYPE; }
+
+    static constexpr void set_operation_type(agrpc::OperationType) noexcept {}
+#endif
+
   protected:
     using OnCompleteFunction = void (*)(TypeErasedOperation*, detail::InvokeHandler, Signature...);
 
     explicit TypeErasedOperation(OnCompleteFunction on_complete) noexcept : on_complete(on_complete) {}
 
   private:
+    // Intrusively listable operations are only ever submitted to the local or remote work queue
+    static constexpr agrpc::OperationType DEFAULT_OPERATION_TYPE =
+        IsIntrusivelyListable ? agrpc::OperationType::POST : agrpc::OperationType::UNKNOWN;
+
     OnCompleteFunction on_complete;
+#ifdef AGRPC_ENABLE_OPERATION_TYPE_TRACKING
+    agrpc::OperationType type{DEFAULT_OPERATION_TYPE};
+#endif
 };
 
 using TypeErasedNoArgOperation = detail::TypeErasedOperation<true, detail::GrpcContextLocalAllocator>;
@@ -62,10 +80,12 @@ void default_do_complete(Base* op, detail::InvokeHandler invoke_handler, Args...
 {
     auto* self = static_cast<Operation*>(op);
     detail::AllocatedPointer ptr{self, self->get_allocator()};
+    // The operation might be stored in memory that is owned by the completion handler, e.g. a coroutine frame. The
+    // handler must therefore be moved out of the operation before the operation is destroyed.
+    auto handler{std::move(self->completion_handler())};
+    ptr.reset();
     if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
     {
-        auto handler{std::move(self->completion_handler())};
-        ptr.reset();
         std::move(handler)(detail::forward_as<Args>(args)...);
     }
 }
@@ -0,0 +1,216 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_UNARYCALL_HPP
+#define AGRPC_DETAIL_UNARYCALL_HPP
+
+#include "agrpc/detail/asioForward.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/forward.hpp"
+#include "agrpc/detail/grpcContext.hpp"
+#include "agrpc/detail/receiver.hpp"
+#include "agrpc/detail/rpc.hpp"
+#include "agrpc/detail/senderOf.hpp"
+#include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/detail/utility.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/support/async_unary_call.h>
+#include <grpcpp/support/status.h>
+
+#include <memory>
+#include <utility>
+
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+#include "agrpc/detail/associatedCompletionHandler.hpp"
+#include "agrpc/detail/initiate.hpp"
+#endif
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+template <class Stub, class Request, class Response>
+struct ClientUnaryCallInitFunction
+{
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::FINISH;
+
+    detail::ClientUnaryRequest<Stub, Request, Response> rpc;
+    Stub& stub;
+    grpc::ClientContext& client_context;
+    const Request& request;
+    Response& response;
+
+    void start(agrpc::GrpcContext& grpc_context, std::unique_ptr<grpc::ClientAsyncResponseReader<Response>>& reader,
+               grpc::Status& status, void* tag)
+    {
+        reader = (stub.*rpc)(&client_context, request, grpc_context.get_completion_queue());
+        reader->StartCall();
+        reader->Finish(&response, &status, tag);
+    }
+
+    template <class T>
+    void operator()(agrpc::GrpcContext& grpc_context, T* tag)
+    {
+        auto& completion_handler = tag->completion_handler();
+        this->start(grpc_context, completion_handler.reader(), completion_handler.status(), tag);
+    }
+};
+
+template <class Stub, class Request, class Response>
+class UnaryCallSender : public detail::SenderOf<grpc::Status>
+{
+  private:
+    using InitFunction = detail::ClientUnaryCallInitFunction<Stub, Request, Response>;
+
+    template <class Receiver>
+    class Operation : private detail::TypeErasedGrpcTagOperation
+    {
+      public:
+        template <class Receiver2>
+        Operation(const UnaryCallSender& sender, Receiver2&& receiver)
+            : detail::TypeErasedGrpcTagOperation(&Operation::on_complete),
+              impl(sender.grpc_context, std::forward<Receiver2>(receiver)),
+              init_function(sender.init_function)
+        {
+        }
+
+        void start() noexcept
+        {
+            if AGRPC_UNLIKELY (detail::GrpcContextImplementation::is_shutdown(this->grpc_context()))
+            {
+                detail::exec::set_done(std::move(this->receiver()));
+                return;
+            }
+            if (detail::exec::get_stop_token(this->receiver()).stop_requested())
+            {
+                detail::exec::set_done(std::move(this->receiver()));
+                return;
+            }
+            this->grpc_context().work_started();
+            detail::WorkFinishedOnExit on_exit{this->grpc_context()};
+            this->set_operation_type(InitFunction::OPERATION_TYPE);
+            init_function.start(this->grpc_context(), reader, status, this);
+            on_exit.release();
+        }
+
+      private:
+        static void on_complete(detail::TypeErasedGrpcTagOperation* op, detail::InvokeHandler invoke_handler, bool,
+                                detail::GrpcContextLocalAllocator) noexcept
+        {
+            auto& self = *static_cast<Operation*>(op);
+            self.reader.reset();
+            if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+            {
+                detail::satisfy_receiver(std::move(self.receiver()), std::move(self.status));
+            }
+            else
+            {
+                detail::exec::set_done(std::move(self.receiver()));
+            }
+        }
+
+        constexpr decltype(auto) grpc_context() noexcept { return impl.first(); }
+
+        constexpr decltype(auto) receiver() noexcept { return impl.second(); }
+
+        detail::CompressedPair<agrpc::GrpcContext&, Receiver> impl;
+        InitFunction init_function;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader;
+        grpc::Status status;
+    };
+
+  public:
+    template <class Receiver>
+    auto connect(Receiver&& receiver) const noexcept(std::is_nothrow_constructible_v<Receiver, Receiver&&>)
+        -> Operation<detail::RemoveCvrefT<Receiver>>
+    {
+        return {*this, std::forward<Receiver>(receiver)};
+    }
+
+  private:
+    UnaryCallSender(agrpc::GrpcContext& grpc_context, InitFunction init_function) noexcept
+        : grpc_context(grpc_context), init_function(init_function)
+    {
+    }
+
+    friend agrpc::detail::UnaryCallFn;
+
+    agrpc::GrpcContext& grpc_context;
+    InitFunction init_function;
+};
+
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+// Stores the reader and the status of a unary call inline with the completion handler, which in turn lives in the
+// operation that is allocated by grpc_submit or, for `asio::use_awaitable`, in the coroutine frame.
+template <class CompletionHandler, class Response>
+class UnaryCallCompletionHandler : public detail::AssociatedCompletionHandler<CompletionHandler>
+{
+  private:
+    using Base = detail::AssociatedCompletionHandler<CompletionHandler>;
+
+  public:
+    template <class... Args>
+    explicit UnaryCallCompletionHandler(Args&&... args) : Base(std::forward<Args>(args)...)
+    {
+    }
+
+    decltype(auto) operator()(bool) &&
+    {
+        // The reader has been allocated on the call's arena and is no longer needed
+        this->reader_.reset();
+        return static_cast<Base&&>(*this)(std::move(this->status_));
+    }
+
+    [[nodiscard]] constexpr auto& reader() noexcept { return reader_; }
+
+    [[nodiscard]] constexpr auto& status() noexcept { return status_; }
+
+  private:
+    std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader_;
+    grpc::Status status_;
+};
+
+// Initiator is detail::GrpcInitiator or detail::GrpcAwaitableInitiator
+template <class Response, class Initiator>
+class UnaryCallInitiator : public Initiator
+{
+  public:
+    using Initiator::Initiator;
+
+    template <class CompletionHandler>
+    void operator()(CompletionHandler&& completion_handler)
+    {
+        Initiator::operator()(detail::UnaryCallCompletionHandler<detail::RemoveCvrefT<CompletionHandler>, Response>{
+            std::forward<CompletionHandler>(completion_handler)});
+    }
+};
+
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+// The buffer in the coroutine frame must additionally hold the reader and the status
+template <class Response, class InitiatingFunction>
+using UnaryCallAwaitableInitiator = detail::UnaryCallInitiator<
+    Response, detail::GrpcAwaitableInitiator<InitiatingFunction, detail::Empty,
+                                             detail::GrpcAwaitableInitiator<InitiatingFunction>::BUFFER_SIZE +
+                                                 sizeof(std::unique_ptr<grpc::ClientAsyncResponseReader<Response>>) +
+                                                 sizeof(grpc::Status)>>;
+#endif
+#endif
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_UNARYCALL_HPP
@@ -17,6 +17,7 @@
 
 #include "agrpc/detail/asioForward.hpp"
 #include "agrpc/detail/config.hpp"
+#include "agrpc/operationType.hpp"
 
 #include <grpcpp/alarm.h>
 
@@ -27,6 +28,8 @@ namespace detail
 template <class Deadline>
 struct AlarmInitFunction
 {
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WAIT;
+
     grpc::Alarm& alarm;
     Deadline deadline;
 
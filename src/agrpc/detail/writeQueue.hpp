@@ -0,0 +1,107 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_DETAIL_WRITEQUEUE_HPP
+#define AGRPC_DETAIL_WRITEQUEUE_HPP
+
+#include "agrpc/detail/associatedCompletionHandler.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/initiate.hpp"
+#include "agrpc/detail/intrusiveQueueHook.hpp"
+#include "agrpc/detail/rpc.hpp"
+#include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/detail/utility.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <utility>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+// A write() or flush() waiting in a WriteQueue. A flush() has no message.
+template <class Message>
+struct WriteQueueEntry : detail::IntrusiveQueueHook<WriteQueueEntry<Message>>
+{
+    const Message* message;
+    detail::TypeErasedGrpcTagOperation* tag;
+};
+
+// Stores the queue entry inline with the completion handler, which in turn lives in the operation that is allocated by
+// grpc_submit. Enqueuing a message therefore does not allocate any memory on its own.
+template <class CompletionHandler, class Message>
+class WriteQueueCompletionHandler : public detail::AssociatedCompletionHandler<CompletionHandler>
+{
+  private:
+    using Base = detail::AssociatedCompletionHandler<CompletionHandler>;
+
+  public:
+    template <class... Args>
+    explicit WriteQueueCompletionHandler(Args&&... args) : Base(std::forward<Args>(args)...)
+    {
+    }
+
+    [[nodiscard]] constexpr auto& entry() noexcept { return entry_; }
+
+  private:
+    detail::WriteQueueEntry<Message> entry_;
+};
+
+struct WriteQueueAccess
+{
+    template <class WriteQueue, class Entry>
+    static void enqueue(WriteQueue& queue, Entry& entry)
+    {
+        queue.enqueue(entry);
+    }
+};
+
+template <class WriteQueue>
+struct WriteQueueInitFunction
+{
+    static constexpr agrpc::OperationType OPERATION_TYPE = agrpc::OperationType::WRITE;
+
+    WriteQueue& queue;
+    const typename WriteQueue::message_type* message;
+
+    template <class T>
+    void operator()(agrpc::GrpcContext&, T* tag) const
+    {
+        auto& entry = tag->completion_handler().entry();
+        entry.message = message;
+        entry.tag = tag;
+        detail::WriteQueueAccess::enqueue(queue, entry);
+    }
+};
+
+template <class Message, class InitiatingFunction>
+class WriteQueueInitiator : public detail::GrpcInitiator<InitiatingFunction>
+{
+  public:
+    using detail::GrpcInitiator<InitiatingFunction>::GrpcInitiator;
+
+    template <class CompletionHandler>
+    void operator()(CompletionHandler&& completion_handler)
+    {
+        detail::GrpcInitiator<InitiatingFunction>::operator()(
+            detail::WriteQueueCompletionHandler<detail::RemoveCvrefT<CompletionHandler>, Message>{
+                std::forward<CompletionHandler>(completion_handler)});
+    }
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_DETAIL_WRITEQUEUE_HPP
@@ -25,15 +25,159 @@
 #include "agrpc/detail/intrusiveQueue.hpp"
 #include "agrpc/detail/memoryResource.hpp"
 #include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/operationType.hpp"
 
 #include <grpcpp/alarm.h>
 #include <grpcpp/completion_queue.h>
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
 #include <thread>
 
 AGRPC_NAMESPACE_BEGIN()
 
+/**
+ * @brief (experimental) Work performed during one round of the GrpcContext's event loop
+ *
+ * A round consists of processing the local and remote work queues followed by the retrieval of up to
+ * `Traits::MAX_COMPLETION_QUEUE_EVENTS` events from the `grpc::CompletionQueue`.
+ *
+ * @since 1.6.0
+ */
+struct RunRoundStatistics
+{
+    /**
+     * @brief Number of completed operations that had been posted to the GrpcContext, locally or from other threads
+     */
+    std::size_t local_operations{};
+
+    /**
+     * @brief Number of events that have been retrieved from the `grpc::CompletionQueue`
+     */
+    std::size_t completion_queue_events{};
+};
+
+/**
+ * @brief (experimental) Snapshot of the runtime metrics of a GrpcContext
+ *
+ * Metrics are only collected while the GrpcContext is being run with traits that set `ENABLE_METRICS` to true, see
+ * `agrpc::DefaultRunTraits`. All values are accumulated since construction of the GrpcContext.
+ *
+ * @since 1.6.0
+ */
+struct GrpcContextMetrics
+{
+    /**
+     * @brief Number of completed operations that have been retrieved from the `grpc::CompletionQueue`
+     */
+    std::size_t completion_queue_events{};
+
+    /**
+     * @brief Number of completed operations that had been posted to the GrpcContext, locally or from other threads
+     */
+    std::size_t local_operations{};
+
+    /**
+     * @brief Number of operations that have been submitted from other threads, a subset of `local_operations`
+     */
+    std::size_t remote_operations{};
+
+    /**
+     * @brief Number of times that the GrpcContext was woken up from the `grpc::CompletionQueue` to process remote work
+     */
+    std::size_t work_alarm_wakeups{};
+
+    /**
+     * @brief Total time spent blocked on the `grpc::CompletionQueue` waiting for events
+     *
+     * A large value relative to the wall-clock time indicates that the GrpcContext is mostly waiting for the network,
+     * a small value that it is busy executing completion handlers.
+     */
+    std::chrono::nanoseconds blocked_duration{};
+
+    /**
+     * @brief Largest number of posted operations that were queued at the beginning of a round of the event loop
+     */
+    std::size_t max_local_queue_depth{};
+};
+
+/**
+ * @brief (experimental) Default GrpcContext run traits
+ *
+ * Inherit from this type and override individual members to customize the behavior of GrpcContext#run<Traits>() and
+ * GrpcContext#poll<Traits>(). Example:
+ *
+ * @code{cpp}
+ * struct MyTraits : agrpc::DefaultRunTraits
+ * {
+ *   static constexpr std::size_t MAX_COMPLETION_QUEUE_EVENTS = 64;
+ * };
+ * grpc_context.run<MyTraits>();
+ * @endcode
+ *
+ * @since 1.6.0
+ */
+struct DefaultRunTraits
+{
+    /**
+     * @brief Maximum number of `grpc::CompletionQueue` events to process before checking for local and remote work
+     *
+     * After the first event of a round has been obtained, further events are retrieved without blocking until this
+     * limit is reached or the `grpc::CompletionQueue` has no more ready events. Larger values reduce the per-event
+     * overhead under load at the cost of delaying posted completion handlers.
+     */
+    static constexpr std::size_t MAX_COMPLETION_QUEUE_EVENTS = 1;
+
+    /**
+     * @brief Maximum number of posted operations to complete before checking the `grpc::CompletionQueue` again
+     *
+     * Operations that exceed this budget remain queued for the next round. Lower values prevent long chains of posted
+     * completion handlers from delaying completion queue events, e.g. of latency-sensitive unary RPCs.
+     */
+    static constexpr std::size_t MAX_LOCAL_OPERATIONS = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Duration for which run() busy-polls the `grpc::CompletionQueue` before blocking on it
+     *
+     * When there is no more work to be processed, run() polls the `grpc::CompletionQueue` without blocking for up to
+     * this duration before it falls back to a blocking wait. Trades CPU time for lower wakeup latency. Zero disables
+     * busy-polling. Has no effect on poll().
+     */
+    static constexpr std::chrono::microseconds BUSY_POLL_DURATION{};
+
+    /**
+     * @brief Collect runtime metrics that can be obtained through GrpcContext#metrics()
+     *
+     * Metrics collection is removed at compile-time when disabled.
+     */
+    static constexpr bool ENABLE_METRICS = false;
+
+    /**
+     * @brief Invoked at the end of every round of the event loop
+     *
+     * Can be used to observe the effect of the above budgets.
+     */
+    static void on_round_completed(agrpc::GrpcContext&, const agrpc::RunRoundStatistics&) noexcept {}
+
+    /**
+     * @brief Measure the execution time of every completed operation and pass it to on_operation_completed()
+     *
+     * Adds two reads of `std::chrono::steady_clock` per operation. Removed at compile-time when disabled.
+     */
+    static constexpr bool ENABLE_OPERATION_TIMING = false;
+
+    /**
+     * @brief Invoked after an operation has been completed, only if `ENABLE_OPERATION_TIMING` is true
+     *
+     * The duration covers the invocation of the completion handler including the deallocation of the operation. May be
+     * invoked concurrently when the GrpcContext is run from multiple threads. See `agrpc::OperationLatencyHistograms`
+     * for a lock-free way to record the durations.
+     */
+    static void on_operation_completed(agrpc::GrpcContext&, agrpc::OperationType, std::chrono::nanoseconds) noexcept {}
+};
+
 /**
  * @brief Execution context based on `grpc::CompletionQueue`
  *
@@ -41,7 +185,7 @@ AGRPC_NAMESPACE_BEGIN()
  * [ExecutionContext](https://www.boost.org/doc/libs/1_78_0/doc/html/boost_asio/reference/ExecutionContext.html)
  * requirements and can therefore be used in all places where Asio expects a `ExecutionContext`.
  *
- * Performance recommendation: Use one GrpcContext per thread.
+ * Performance recommendation: Use one GrpcContext per thread, see `agrpc::GrpcContextPool`.
  */
 class GrpcContext
 #if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
@@ -72,6 +216,36 @@ class GrpcContext
      */
     explicit GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& completion_queue);
 
+    /**
+     * @brief (experimental) Construct a GrpcContext that may be run from multiple threads concurrently
+     *
+     * If `concurrency_hint` is greater than one then run() and poll() may be called from multiple threads at the same
+     * time, all of them draining the same `grpc::CompletionQueue`. Completion handlers of posted operations are
+     * queued thread-locally and completion queue events are distributed by gRPC among all running threads.
+     *
+     * In this mode the GrpcContext does not use its local memory pool for operations, they are allocated using the
+     * completion handler's associated allocator instead. get_allocator() must not be used.
+     *
+     * @since 1.6.0
+     */
+    GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& completion_queue, std::size_t concurrency_hint);
+
+    /**
+     * @brief (experimental) Construct a GrpcContext whose local memory pool obtains memory from the given resource
+     *
+     * The local memory pool, see get_allocator() and reserve(), requests memory from `upstream_resource` instead of
+     * the global allocator. This can be used to place the memory of operations on pages that are local to the thread
+     * that runs the GrpcContext, e.g. by passing a NUMA-local or huge page backed arena. The resource is either a
+     * `std::pmr::memory_resource` or, if `ASIO_GRPC_USE_BOOST_CONTAINER` is enabled, a
+     * `boost::container::pmr::memory_resource`.
+     *
+     * @param upstream_resource Must not be null and must outlive the GrpcContext.
+     *
+     * @since 1.6.0
+     */
+    GrpcContext(std::unique_ptr<grpc::CompletionQueue>&& completion_queue,
+                detail::pmr::memory_resource* upstream_resource);
+
     /**
      * @brief Destruct the GrpcContext
      *
@@ -89,23 +263,50 @@ class GrpcContext
      * brought into the ready state when this function is invoked. Upon return, the GrpcContext will be in the stopped
      * state.
      *
-     * @attention Only one thread may call run()/poll() at a time.
+     * @attention Only one thread may call run()/poll() at a time, unless the GrpcContext has been constructed with a
+     * `concurrency_hint` greater than one. In that case only the first thread brings the GrpcContext into the ready
+     * state. A thread that calls run() after stop() while other threads are still running it returns right away.
      *
      * Thread-safe with regards to other functions except run(), poll() and the destructor.
      */
     void run();
 
+    /**
+     * @brief (experimental) Run the `grpc::CompletionQueue` with custom traits
+     *
+     * Same as run() but the behavior of the event loop is customized by the provided traits.
+     *
+     * @tparam Traits The traits type, see `agrpc::DefaultRunTraits`.
+     *
+     * @since 1.6.0
+     */
+    template <class Traits>
+    void run();
+
     /**
      * @brief Poll the `grpc::CompletionQueue`
      *
      * Processes all ready completion handlers.
      *
-     * @attention Only one thread may call run()/poll() at a time.
+     * @attention Only one thread may call run()/poll() at a time, unless the GrpcContext has been constructed with a
+     * `concurrency_hint` greater than one.
      *
      * Thread-safe with regards to other functions except run(), poll() and the destructor.
      */
     void poll();
 
+    /**
+     * @brief (experimental) Poll the `grpc::CompletionQueue` with custom traits
+     *
+     * Same as poll() but the behavior of the event loop is customized by the provided traits.
+     *
+     * @tparam Traits The traits type, see `agrpc::DefaultRunTraits`.
+     *
+     * @since 1.6.0
+     */
+    template <class Traits>
+    void poll();
+
     /**
      * @brief Signal the GrpcContext to stop
      *
@@ -149,12 +350,60 @@ class GrpcContext
     /**
      * @brief Get the associated allocator
      *
-     * @attention The returned allocator may only be used for allocations within the same thread that calls run().
+     * @attention The returned allocator may only be used for allocations within the same thread that calls run(). It
+     * must not be used at all if the GrpcContext has been constructed with a `concurrency_hint` greater than one.
      *
      * Thread-safe
      */
     [[nodiscard]] allocator_type get_allocator() noexcept;
 
+    /**
+     * @brief (experimental) Pre-allocate memory for operations
+     *
+     * Operations that are initiated from within the thread that calls run() obtain their memory from a size-class
+     * based pool owned by this GrpcContext. This function ensures that at least `count` blocks of the size class that
+     * serves allocations of `size` bytes are available, so that they can later be obtained without calling into the
+     * global allocator. Memory is never returned from the pool to the global allocator before the GrpcContext is
+     * destructed. Each size class holds at most 4096 blocks, operations that are allocated while their size class is
+     * exhausted obtain their memory from the global allocator. Sizes above 1024 bytes are not pooled and are ignored by
+     * this function. Unlike in versions before 1.6.0, operations of such size call into the global allocator every
+     * time.
+     *
+     * Not thread-safe. Must not be called concurrently with run().
+     *
+     * @since 1.6.0
+     */
+    void reserve(std::size_t size, std::size_t count);
+
+    /**
+     * @brief (experimental) Get the resource from which the local memory pool obtains its memory
+     *
+     * Thread-safe
+     *
+     * @since 1.6.0
+     */
+    [[nodiscard]] detail::pmr::memory_resource* get_upstream_resource() const noexcept;
+
+    /**
+     * @brief (experimental) Pre-allocate memory for operations that are submitted from other threads
+     *
+     * By default, operations that are initiated from a thread that is not running the GrpcContext, e.g. through
+     * `asio::post`, are allocated using the completion handler's associated allocator. If that is the
+     * `std::allocator` then this function provides a lock-free pool of `count` blocks of 128 bytes each to be used
+     * for them instead. The blocks are returned to the pool in batches by the thread that runs the GrpcContext, or one
+     * by one while the pool is exhausted. When the pool is exhausted or an operation does not fit into a block then the
+     * global allocator is used.
+     *
+     * The pool is not used by GrpcContexts that have been constructed with a `concurrency_hint` greater than one or
+     * that take part in work stealing.
+     *
+     * Only the first call has an effect. Not thread-safe, must be called before any operation is submitted to the
+     * GrpcContext.
+     *
+     * @since 1.6.0
+     */
+    void reserve_remote_operations(std::size_t count);
+
     /**
      * @brief Signal that work has started
      *
@@ -173,6 +422,25 @@ class GrpcContext
      */
     void work_finished() noexcept;
 
+    /**
+     * @brief (experimental) Get a snapshot of the runtime metrics
+     *
+     * All values remain zero unless the GrpcContext is run with traits that enable metrics:
+     *
+     * @code{cpp}
+     * struct MetricsTraits : agrpc::DefaultRunTraits
+     * {
+     *   static constexpr bool ENABLE_METRICS = true;
+     * };
+     * grpc_context.run<MetricsTraits>();
+     * @endcode
+     *
+     * Thread-safe
+     *
+     * @since 1.6.0
+     */
+    [[nodiscard]] agrpc::GrpcContextMetrics metrics() const noexcept;
+
     /**
      * @brief Get the underlying `grpc::CompletionQueue`
      *
@@ -206,13 +474,19 @@ class GrpcContext
 
     grpc::Alarm work_alarm;
     std::atomic_long outstanding_work{};
+    std::atomic_size_t running_threads{};
     std::atomic_bool stopped{false};
     std::atomic_bool shutdown{false};
-    bool check_remote_work{false};
+    std::atomic_bool check_remote_work{false};
+    bool is_multithreaded{false};
+    detail::WorkStealingGroup* work_stealing_group{};
+    detail::GrpcContextMetricsCounters metrics_counters;
     std::unique_ptr<grpc::CompletionQueue> completion_queue;
     detail::GrpcContextLocalMemoryResource local_resource{detail::pmr::new_delete_resource()};
+    detail::RemoteMemoryPool remote_resource;
     LocalWorkQueue local_work_queue;
     RemoteWorkQueue remote_work_queue{false};
+    RemoteWorkQueue stealable_work_queue;
 };
 
 AGRPC_NAMESPACE_END
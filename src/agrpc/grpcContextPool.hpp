@@ -0,0 +1,323 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_GRPCCONTEXTPOOL_HPP
+#define AGRPC_AGRPC_GRPCCONTEXTPOOL_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/grpcContextImplementation.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/grpcExecutor.hpp"
+#include "agrpc/repeatedlyRequest.hpp"
+
+#include <grpcpp/completion_queue.h>
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Policy used by GrpcContextPool to select the next GrpcContext
+ *
+ * @since 1.6.0
+ */
+enum class GrpcContextPoolPolicy
+{
+    /**
+     * @brief Cycle through the GrpcContexts in order
+     */
+    ROUND_ROBIN,
+
+    /**
+     * @brief Select the GrpcContext with the fewest outstanding operations
+     */
+    LEAST_OUTSTANDING_WORK
+};
+
+/**
+ * @brief (experimental) A fixed-size pool of GrpcContexts, each run by its own thread
+ *
+ * Implements the "one GrpcContext per thread" recommendation. Every GrpcContext of the pool owns its own
+ * `grpc::CompletionQueue`, which is obtained from the factory that is passed to the constructor. The pool keeps each
+ * GrpcContext from running out of work until join() or stop() are called.
+ *
+ * Example showing how to create a pool for a server:
+ *
+ * @code{cpp}
+ * grpc::ServerBuilder builder;
+ * agrpc::GrpcContextPool pool{std::thread::hardware_concurrency(), [&]
+ *                             {
+ *                                 return builder.AddCompletionQueue();
+ *                             }};
+ * builder.RegisterService(&service);
+ * auto server = builder.BuildAndStart();
+ * pool.repeatedly_request(&Service::RequestUnary, service,
+ *                         [&](agrpc::GrpcContext& grpc_context)
+ *                         {
+ *                             return RequestHandler{grpc_context};
+ *                         });
+ * pool.start();
+ * @endcode
+ *
+ * @since 1.6.0
+ */
+class GrpcContextPool
+{
+  public:
+    /**
+     * @brief The associated executor type
+     */
+    using executor_type = agrpc::GrpcContext::executor_type;
+
+    /**
+     * @brief Construct a GrpcContextPool
+     *
+     * @param size The number of GrpcContexts and threads, must be greater than zero.
+     * @param completion_queue_factory Invoked once per GrpcContext. Its signature should be
+     * `std::unique_ptr<grpc::CompletionQueue>()`, `grpc::ServerBuilder::AddCompletionQueue()` for example.
+     */
+    template <class CompletionQueueFactory>
+    GrpcContextPool(std::size_t size, CompletionQueueFactory&& completion_queue_factory)
+    {
+        grpc_contexts.reserve(size);
+        for (std::size_t i{}; i < size; ++i)
+        {
+            std::unique_ptr<grpc::CompletionQueue> completion_queue{completion_queue_factory()};
+            auto& grpc_context =
+                *grpc_contexts.emplace_back(std::make_unique<agrpc::GrpcContext>(std::move(completion_queue)));
+            grpc_context.work_started();
+        }
+    }
+
+    /**
+     * @brief Construct a GrpcContextPool for client-side use only
+     *
+     * Each GrpcContext is given a default constructed `grpc::CompletionQueue`.
+     */
+    explicit GrpcContextPool(std::size_t size)
+        : GrpcContextPool(size,
+                          []
+                          {
+                              return std::make_unique<grpc::CompletionQueue>();
+                          })
+    {
+    }
+
+    /**
+     * @brief Destruct the GrpcContextPool
+     *
+     * Calls stop() followed by join().
+     */
+    ~GrpcContextPool()
+    {
+        this->stop();
+        this->join();
+        for (auto& grpc_context : grpc_contexts)
+        {
+            detail::GrpcContextImplementation::set_work_stealing_group(*grpc_context, nullptr);
+        }
+    }
+
+    GrpcContextPool(const GrpcContextPool&) = delete;
+    GrpcContextPool(GrpcContextPool&&) = delete;
+    GrpcContextPool& operator=(const GrpcContextPool&) = delete;
+    GrpcContextPool& operator=(GrpcContextPool&&) = delete;
+
+    /**
+     * @brief (experimental) Allow idle GrpcContexts to steal posted operations from their siblings
+     *
+     * When a GrpcContext of this pool runs out of work then it takes the completion handlers that have been posted to
+     * a sibling, e.g. through `asio::post`, and invokes them in its own thread. Events of the `grpc::CompletionQueue`
+     * are never stolen, they are always processed by the GrpcContext that owns the queue. A GrpcContext looks for
+     * work to steal right before it would block on its `grpc::CompletionQueue`, use run traits with a
+     * `BUSY_POLL_DURATION` to make idle GrpcContexts keep looking.
+     *
+     * @attention Completion handlers that are posted to the same GrpcContext may therefore be invoked concurrently
+     * and handlers posted from within the GrpcContext no longer use its local memory pool.
+     *
+     * Must be called before start(). Not thread-safe
+     */
+    void enable_work_stealing()
+    {
+        work_stealing_group.grpc_contexts.clear();
+        for (auto& grpc_context : grpc_contexts)
+        {
+            work_stealing_group.grpc_contexts.emplace_back(grpc_context.get());
+            detail::GrpcContextImplementation::set_work_stealing_group(*grpc_context, &work_stealing_group);
+        }
+    }
+
+    /**
+     * @brief Start one thread per GrpcContext that calls GrpcContext#run()
+     *
+     * Must be called at most once.
+     */
+    void start()
+    {
+        threads.reserve(grpc_contexts.size());
+        for (auto& grpc_context : grpc_contexts)
+        {
+            threads.emplace_back(
+                [&context = *grpc_context]
+                {
+                    context.run();
+                });
+        }
+    }
+
+    /**
+     * @brief Allow the GrpcContexts to run out of work and wait for all threads to exit
+     *
+     * Not thread-safe
+     */
+    void join()
+    {
+        if (!has_released_work)
+        {
+            has_released_work = true;
+            for (auto& grpc_context : grpc_contexts)
+            {
+                grpc_context->work_finished();
+            }
+        }
+        for (auto& thread : threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+
+    /**
+     * @brief Signal all GrpcContexts to stop
+     *
+     * Thread-safe
+     */
+    void stop()
+    {
+        for (auto& grpc_context : grpc_contexts)
+        {
+            grpc_context->stop();
+        }
+    }
+
+    /**
+     * @brief The number of GrpcContexts in this pool
+     *
+     * Thread-safe
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return grpc_contexts.size(); }
+
+    /**
+     * @brief Get the GrpcContext at the given index
+     *
+     * Thread-safe
+     */
+    [[nodiscard]] agrpc::GrpcContext& get_context(std::size_t index) noexcept { return *grpc_contexts[index]; }
+
+    /**
+     * @brief Select a GrpcContext according to the given policy
+     *
+     * `GrpcContextPoolPolicy::LEAST_OUTSTANDING_WORK` inspects the outstanding work counter of every GrpcContext. Ties
+     * are broken in round-robin order.
+     *
+     * Thread-safe
+     */
+    [[nodiscard]] agrpc::GrpcContext& get_next_context(
+        agrpc::GrpcContextPoolPolicy policy = agrpc::GrpcContextPoolPolicy::ROUND_ROBIN) noexcept
+    {
+        const auto size = grpc_contexts.size();
+        const auto start = next_index.fetch_add(1, std::memory_order_relaxed) % size;
+        if (agrpc::GrpcContextPoolPolicy::ROUND_ROBIN == policy)
+        {
+            return *grpc_contexts[start];
+        }
+        auto best = start;
+        auto best_work = std::numeric_limits<long>::max();
+        for (std::size_t i{}; i < size; ++i)
+        {
+            const auto index = (start + i) % size;
+            const auto work = detail::GrpcContextImplementation::get_outstanding_work(*grpc_contexts[index]);
+            if (work < best_work)
+            {
+                best = index;
+                best_work = work;
+            }
+        }
+        return *grpc_contexts[best];
+    }
+
+    /**
+     * @brief Get the executor of a GrpcContext selected according to the given policy
+     *
+     * Thread-safe
+     */
+    [[nodiscard]] executor_type get_next_executor(
+        agrpc::GrpcContextPoolPolicy policy = agrpc::GrpcContextPoolPolicy::ROUND_ROBIN) noexcept
+    {
+        return this->get_next_context(policy).get_executor();
+    }
+
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+    /**
+     * @brief Register a request handler on every GrpcContext of this pool
+     *
+     * Calls `agrpc::repeatedly_request` once per GrpcContext. Incoming RPCs are therefore distributed by gRPC across
+     * all completion queues of the pool. Requires that all completion queues have been obtained from the same
+     * `grpc::ServerBuilder` that the service was registered with.
+     *
+     * Example:
+     *
+     * @code{cpp}
+     * pool.repeatedly_request(&Service::RequestUnary, service,
+     *                         [&](agrpc::GrpcContext& grpc_context)
+     *                         {
+     *                             return asio::bind_executor(grpc_context, request_handler);
+     *                         });
+     * @endcode
+     *
+     * @param request_handler_factory Invoked once per GrpcContext. Its signature should be
+     * `RequestHandler(agrpc::GrpcContext&)`. The returned RequestHandler must have an associated executor that refers
+     * to the provided GrpcContext. See `agrpc::repeatedly_request` for the requirements on the RequestHandler.
+     *
+     * Not thread-safe
+     */
+    template <class RPC, class Service, class RequestHandlerFactory>
+    void repeatedly_request(RPC rpc, Service& service, RequestHandlerFactory&& request_handler_factory)
+    {
+        for (auto& grpc_context : grpc_contexts)
+        {
+            agrpc::repeatedly_request(rpc, service, request_handler_factory(*grpc_context));
+        }
+    }
+#endif
+
+  private:
+    std::vector<std::unique_ptr<agrpc::GrpcContext>> grpc_contexts;
+    detail::WorkStealingGroup work_stealing_group;
+    std::vector<std::thread> threads;
+    std::atomic_size_t next_index{};
+    bool has_released_work{false};
+};
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_GRPCCONTEXTPOOL_HPP
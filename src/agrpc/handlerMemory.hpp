@@ -0,0 +1,244 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_HANDLERMEMORY_HPP
+#define AGRPC_AGRPC_HANDLERMEMORY_HPP
+
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+
+#include "agrpc/bindAllocator.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/forward.hpp"
+#include "agrpc/detail/handlerMemory.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Exact amount of memory that an asio-grpc operation needs for a given completion handler
+ *
+ * Computed from the operation type that the GrpcContext would allocate for `CompletionHandler` when it is passed to an
+ * RPC function or `agrpc::wait`. Executor, allocator and cancellation slot binders are stripped the same way as during
+ * initiation. Use it to size an agrpc::HandlerMemory at compile-time:
+ *
+ * @code{cpp}
+ * using Handler = agrpc::AllocatorBinder<MyCallback, agrpc::HandlerMemoryAllocator<std::byte, 1>>;
+ * agrpc::HandlerMemory<agrpc::HANDLER_MEMORY_SIZE_V<Handler>> memory;
+ * @endcode
+ *
+ * Operations that are allocated by other execution contexts, like an `asio::post` onto an `asio::io_context`, are not
+ * covered.
+ *
+ * @since 1.6.0
+ */
+template <class CompletionHandler>
+inline constexpr std::size_t HANDLER_MEMORY_SIZE_V = detail::HANDLER_MEMORY_SIZE<CompletionHandler>;
+
+/**
+ * @brief (experimental) Allocator that hands out the memory of an agrpc::HandlerMemory
+ *
+ * Obtained from agrpc::HandlerMemory::get_allocator. Copies compare equal if they refer to the same HandlerMemory.
+ *
+ * @since 1.6.0
+ */
+template <class T, std::size_t Capacity>
+class HandlerMemoryAllocator
+{
+  public:
+    /**
+     * @brief The value type
+     */
+    using value_type = T;
+
+    /**
+     * @brief Rebind this allocator to a different value type
+     */
+    template <class U>
+    struct rebind
+    {
+        using other = agrpc::HandlerMemoryAllocator<U, Capacity>;
+    };
+
+    /**
+     * @brief Construct from an agrpc::HandlerMemory
+     */
+    constexpr explicit HandlerMemoryAllocator(agrpc::HandlerMemory<Capacity>& memory) noexcept : memory(&memory) {}
+
+    /**
+     * @brief Construct from an allocator of a different value type
+     */
+    template <class U>
+    constexpr HandlerMemoryAllocator(const agrpc::HandlerMemoryAllocator<U, Capacity>& other) noexcept
+        : memory(other.memory)
+    {
+    }
+
+    /**
+     * @brief Allocate memory for `n` objects of type `T`
+     *
+     * Returns the buffer of the HandlerMemory if it is unused and large enough. Otherwise increments its overflow count
+     * and falls back to `std::allocator`.
+     */
+    [[nodiscard]] T* allocate(std::size_t n)
+    {
+        if (void* buffer = memory->try_acquire(n * sizeof(T), alignof(T)))
+        {
+            return static_cast<T*>(buffer);
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    /**
+     * @brief Deallocate memory that was obtained from `allocate`
+     */
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (!memory->release(p))
+        {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+    }
+
+    template <class U>
+    friend constexpr bool operator==(const HandlerMemoryAllocator& lhs,
+                                     const agrpc::HandlerMemoryAllocator<U, Capacity>& rhs) noexcept
+    {
+        return lhs.memory == rhs.memory;
+    }
+
+    template <class U>
+    friend constexpr bool operator!=(const HandlerMemoryAllocator& lhs,
+                                     const agrpc::HandlerMemoryAllocator<U, Capacity>& rhs) noexcept
+    {
+        return lhs.memory != rhs.memory;
+    }
+
+  private:
+    template <class, std::size_t>
+    friend class agrpc::HandlerMemoryAllocator;
+
+    agrpc::HandlerMemory<Capacity>* memory;
+};
+
+/**
+ * @brief (experimental) Reusable, fixed-size memory for one outstanding operation at a time
+ *
+ * Intended to be bound to the completion token of sequential operations, e.g. the reads of a streaming RPC within one
+ * coroutine:
+ *
+ * @code{cpp}
+ * agrpc::HandlerMemory<agrpc::HANDLER_MEMORY_SIZE_V<Handler>> memory;
+ * while (co_await agrpc::read(reader, response, memory.bind(asio::use_awaitable)))
+ * {
+ * }
+ * @endcode
+ *
+ * The buffer becomes available again as soon as the operation that occupies it has completed, before its completion
+ * handler is invoked. If an allocation does not fit into the buffer, because it is too large or because another
+ * operation still occupies the buffer, then memory is obtained from `std::allocator` instead and `overflow_count()` is
+ * incremented. A `Capacity` that is too small therefore costs performance but never correctness. Check
+ * `overflow_count()` in tests to detect it.
+ *
+ * This class is not thread-safe. It must outlive all operations that use its allocator and is neither copyable nor
+ * movable.
+ *
+ * @tparam Capacity Size of the buffer in bytes
+ *
+ * @since 1.6.0
+ */
+template <std::size_t Capacity>
+class HandlerMemory
+{
+  public:
+    /**
+     * @brief The allocator type
+     */
+    using allocator_type = agrpc::HandlerMemoryAllocator<std::byte, Capacity>;
+
+    /**
+     * @brief Size of the buffer in bytes
+     */
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    HandlerMemory() = default;
+
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory(HandlerMemory&&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(HandlerMemory&&) = delete;
+
+    /**
+     * @brief Get an allocator that refers to this HandlerMemory
+     */
+    [[nodiscard]] allocator_type get_allocator() noexcept { return allocator_type{*this}; }
+
+    /**
+     * @brief Bind the allocator of this HandlerMemory to a completion token or handler
+     */
+    template <class Target>
+    [[nodiscard]] auto bind(Target&& target) noexcept
+    {
+        return agrpc::bind_allocator(this->get_allocator(), std::forward<Target>(target));
+    }
+
+    /**
+     * @brief Number of allocations that did not fit into the buffer
+     */
+    [[nodiscard]] std::size_t overflow_count() const noexcept { return overflow_count_; }
+
+    /**
+     * @brief Whether the buffer is currently occupied by an operation
+     */
+    [[nodiscard]] bool in_use() const noexcept { return in_use_; }
+
+  private:
+    template <class, std::size_t>
+    friend class agrpc::HandlerMemoryAllocator;
+
+    void* try_acquire(std::size_t size, std::size_t alignment) noexcept
+    {
+        if AGRPC_LIKELY (!in_use_ && size <= Capacity && alignment <= alignof(std::max_align_t))
+        {
+            in_use_ = true;
+            return buffer;
+        }
+        ++overflow_count_;
+        return nullptr;
+    }
+
+    bool release(void* p) noexcept
+    {
+        if AGRPC_LIKELY (p == buffer)
+        {
+            in_use_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    static_assert(Capacity > 0, "HandlerMemory must have a non-zero capacity");
+
+    alignas(std::max_align_t) std::byte buffer[Capacity];
+    bool in_use_{};
+    std::size_t overflow_count_{};
+};
+
+AGRPC_NAMESPACE_END
+
+#endif
+
+#endif  // AGRPC_AGRPC_HANDLERMEMORY_HPP
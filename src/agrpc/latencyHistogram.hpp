@@ -0,0 +1,234 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_LATENCYHISTOGRAM_HPP
+#define AGRPC_AGRPC_LATENCYHISTOGRAM_HPP
+
+#include "agrpc/detail/config.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+constexpr std::size_t floor_log2(std::uint64_t value) noexcept
+{
+    std::size_t result{};
+    for (std::size_t shift = 32; shift > 0; shift /= 2)
+    {
+        if (value >= (std::uint64_t{1} << shift))
+        {
+            value >>= shift;
+            result += shift;
+        }
+    }
+    return result;
+}
+}
+
+/**
+ * @brief (experimental) Lock-free histogram of durations
+ *
+ * Buckets are arranged log-linearly like those of an HdrHistogram: every power of two is divided into 32 equally sized
+ * buckets which bounds the relative error of reported values to about 3%. Durations of up to 2^36 nanoseconds, about
+ * 68 seconds, can be distinguished. Longer ones are recorded as that maximum. A histogram occupies 8 KiB.
+ *
+ * record() is wait-free and may be invoked concurrently with all other member functions. Queries obtain a consistent
+ * view only when no records happen at the same time.
+ *
+ * @since 1.6.0
+ */
+class LatencyHistogram
+{
+  private:
+    static constexpr std::size_t SUB_BUCKET_BITS = 5;
+    static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t MAX_VALUE_BITS = 36;
+
+  public:
+    /**
+     * @brief The number of buckets
+     */
+    static constexpr std::size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+     * @brief The largest duration that can be recorded without being clamped
+     */
+    static constexpr std::chrono::nanoseconds MAX_DURATION{(std::int64_t{1} << MAX_VALUE_BITS) - 1};
+
+    /**
+     * @brief Record a duration
+     *
+     * Thread-safe
+     */
+    void record(std::chrono::nanoseconds duration) noexcept
+    {
+        buckets[LatencyHistogram::index_of(duration)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The number of recorded durations
+     */
+    [[nodiscard]] std::uint64_t count() const noexcept
+    {
+        std::uint64_t total{};
+        for (const auto& bucket : buckets)
+        {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief The duration below or at which the given percentage of recorded durations lie
+     *
+     * Returns the highest duration that is equivalent, within the precision of this histogram, to the recorded one.
+     *
+     * @param percentile Between 0 and 100, e.g. 99.9 for the p999 latency
+     * @return Zero if nothing has been recorded
+     */
+    [[nodiscard]] std::chrono::nanoseconds percentile(double percentile) const noexcept
+    {
+        const auto total = this->count();
+        if (0 == total)
+        {
+            return {};
+        }
+        const auto clamped_percentile = std::clamp(percentile, 0.0, 100.0);
+        const auto target = std::max(
+            std::uint64_t{1},
+            static_cast<std::uint64_t>(std::ceil(clamped_percentile / 100.0 * static_cast<double>(total))));
+        std::uint64_t cumulative{};
+        for (std::size_t index{}; index < BUCKET_COUNT; ++index)
+        {
+            cumulative += buckets[index].load(std::memory_order_relaxed);
+            if (cumulative >= target)
+            {
+                return std::chrono::nanoseconds(LatencyHistogram::lowest_value_of(index + 1) - 1);
+            }
+        }
+        return MAX_DURATION;
+    }
+
+    /**
+     * @brief Remove all recorded durations
+     */
+    void reset() noexcept
+    {
+        for (auto& bucket : buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    static constexpr std::size_t index_of(std::chrono::nanoseconds duration) noexcept
+    {
+        const auto clamped_duration = std::clamp(duration, std::chrono::nanoseconds{}, MAX_DURATION);
+        const auto value = static_cast<std::uint64_t>(clamped_duration.count());
+        if (value < SUB_BUCKET_COUNT)
+        {
+            return static_cast<std::size_t>(value);
+        }
+        const auto shift = detail::floor_log2(value) - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT + static_cast<std::size_t>((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    static constexpr std::uint64_t lowest_value_of(std::size_t index) noexcept
+    {
+        if (index < SUB_BUCKET_COUNT)
+        {
+            return index;
+        }
+        const auto shift = index / SUB_BUCKET_COUNT - 1;
+        return std::uint64_t{SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT} << shift;
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+};
+
+/**
+ * @brief (experimental) One LatencyHistogram per OperationType
+ *
+ * Intended to be used from the `on_operation_completed` hook of the run traits. Example:
+ *
+ * @code{cpp}
+ * inline agrpc::OperationLatencyHistograms histograms;
+ *
+ * struct TimedRunTraits : agrpc::DefaultRunTraits
+ * {
+ *     static constexpr bool ENABLE_OPERATION_TIMING = true;
+ *
+ *     static void on_operation_completed(agrpc::GrpcContext&, agrpc::OperationType type,
+ *                                        std::chrono::nanoseconds duration) noexcept
+ *     {
+ *         histograms.record(type, duration);
+ *     }
+ * };
+ *
+ * grpc_context.run<TimedRunTraits>();
+ * const auto p99 = histograms.get(agrpc::OperationType::READ).percentile(99.0);
+ * @endcode
+ *
+ * Due to its size it should not be allocated on the stack.
+ *
+ * @since 1.6.0
+ */
+class OperationLatencyHistograms
+{
+  public:
+    /**
+     * @brief Record the duration of an operation
+     *
+     * Thread-safe
+     */
+    void record(agrpc::OperationType type, std::chrono::nanoseconds duration) noexcept
+    {
+        histograms[static_cast<std::size_t>(type)].record(duration);
+    }
+
+    /**
+     * @brief Get the histogram of an OperationType
+     */
+    [[nodiscard]] const agrpc::LatencyHistogram& get(agrpc::OperationType type) const noexcept
+    {
+        return histograms[static_cast<std::size_t>(type)];
+    }
+
+    /**
+     * @brief Remove all recorded durations
+     */
+    void reset() noexcept
+    {
+        for (auto& histogram : histograms)
+        {
+            histogram.reset();
+        }
+    }
+
+  private:
+    std::array<agrpc::LatencyHistogram, agrpc::OPERATION_TYPE_COUNT> histograms{};
+};
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_LATENCYHISTOGRAM_HPP
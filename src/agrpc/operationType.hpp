@@ -0,0 +1,166 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_OPERATIONTYPE_HPP
+#define AGRPC_AGRPC_OPERATIONTYPE_HPP
+
+#include "agrpc/detail/config.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) The kind of asynchronous operation that is being completed by a GrpcContext
+ *
+ * Passed to the `on_operation_completed` hook of the run traits. Posted completion handlers are always reported as
+ * `POST`. Operations that complete through the `grpc::CompletionQueue` are labeled by the function that initiated them
+ * only if `AGRPC_ENABLE_OPERATION_TYPE_TRACKING` is defined, which adds one byte to every such operation. Otherwise
+ * they are reported as `UNKNOWN`. The macro changes the layout of operations and the value of
+ * `agrpc::HANDLER_MEMORY_SIZE_V`, it must therefore be defined consistently across all translation units. Prefer
+ * setting the CMake option `ASIO_GRPC_ENABLE_OPERATION_TYPE_TRACKING`, which adds it to the compile definitions of the
+ * asio-grpc targets.
+ *
+ * @since 1.6.0
+ */
+enum class OperationType : unsigned char
+{
+    /**
+     * @brief The operation could not be labeled
+     */
+    UNKNOWN,
+
+    /**
+     * @brief A completion handler submitted through e.g. `asio::post` or a sender created by `agrpc::schedule`
+     */
+    POST,
+
+    /**
+     * @brief `agrpc::wait`
+     */
+    WAIT,
+
+    /**
+     * @brief `agrpc::request` and `agrpc::repeatedly_request`
+     */
+    REQUEST,
+
+    /**
+     * @brief `agrpc::read`
+     */
+    READ,
+
+    /**
+     * @brief `agrpc::write`
+     */
+    WRITE,
+
+    /**
+     * @brief `agrpc::writes_done`
+     */
+    WRITES_DONE,
+
+    /**
+     * @brief `agrpc::finish`
+     */
+    FINISH,
+
+    /**
+     * @brief `agrpc::write_last`
+     */
+    WRITE_LAST,
+
+    /**
+     * @brief `agrpc::write_and_finish`
+     */
+    WRITE_AND_FINISH,
+
+    /**
+     * @brief `agrpc::finish_with_error`
+     */
+    FINISH_WITH_ERROR,
+
+    /**
+     * @brief `agrpc::send_initial_metadata`
+     */
+    SEND_INITIAL_METADATA,
+
+    /**
+     * @brief `agrpc::read_initial_metadata`
+     */
+    READ_INITIAL_METADATA
+};
+
+/**
+ * @brief (experimental) The number of enumerators of OperationType
+ *
+ * @since 1.6.0
+ */
+inline constexpr std::size_t OPERATION_TYPE_COUNT =
+    static_cast<std::size_t>(agrpc::OperationType::READ_INITIAL_METADATA) + 1;
+
+/**
+ * @brief (experimental) Get the name of an OperationType, e.g. `"READ"`
+ *
+ * @since 1.6.0
+ */
+[[nodiscard]] constexpr const char* to_string(agrpc::OperationType type) noexcept
+{
+    switch (type)
+    {
+        case agrpc::OperationType::UNKNOWN:
+            return "UNKNOWN";
+        case agrpc::OperationType::POST:
+            return "POST";
+        case agrpc::OperationType::WAIT:
+            return "WAIT";
+        case agrpc::OperationType::REQUEST:
+            return "REQUEST";
+        case agrpc::OperationType::READ:
+            return "READ";
+        case agrpc::OperationType::WRITE:
+            return "WRITE";
+        case agrpc::OperationType::WRITES_DONE:
+            return "WRITES_DONE";
+        case agrpc::OperationType::FINISH:
+            return "FINISH";
+        case agrpc::OperationType::WRITE_LAST:
+            return "WRITE_LAST";
+        case agrpc::OperationType::WRITE_AND_FINISH:
+            return "WRITE_AND_FINISH";
+        case agrpc::OperationType::FINISH_WITH_ERROR:
+            return "FINISH_WITH_ERROR";
+        case agrpc::OperationType::SEND_INITIAL_METADATA:
+            return "SEND_INITIAL_METADATA";
+        case agrpc::OperationType::READ_INITIAL_METADATA:
+            return "READ_INITIAL_METADATA";
+    }
+    return "UNKNOWN";
+}
+
+namespace detail
+{
+template <class InitiatingFunction, class = void>
+inline constexpr agrpc::OperationType OPERATION_TYPE_V = agrpc::OperationType::UNKNOWN;
+
+template <class InitiatingFunction>
+inline constexpr agrpc::OperationType
+    OPERATION_TYPE_V<InitiatingFunction, std::void_t<decltype(InitiatingFunction::OPERATION_TYPE)>> =
+        InitiatingFunction::OPERATION_TYPE;
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_OPERATIONTYPE_HPP
@@ -17,10 +17,15 @@
 
 #include "agrpc/detail/asioForward.hpp"
 #include "agrpc/detail/config.hpp"
+#include "agrpc/detail/forward.hpp"
 #include "agrpc/detail/repeatedlyRequest.hpp"
 #include "agrpc/detail/repeatedlyRequestSender.hpp"
 #include "agrpc/detail/rpcContext.hpp"
+#include "agrpc/detail/useSender.hpp"
 #include "agrpc/repeatedlyRequestContext.hpp"
+#include "agrpc/repeatedlyRequestOptions.hpp"
+
+#include <type_traits>
 
 AGRPC_NAMESPACE_BEGIN()
 
@@ -66,6 +71,9 @@ namespace detail
  *
  * @snippet server.cpp repeatedly-request-callback
  *
+ * The overloads that take an `agrpc::RepeatedlyRequestOptions` allow tuning the registration, e.g. to recycle RPC
+ * contexts instead of allocating a new one for every request. They cannot be used with `agrpc::use_sender`.
+ *
  * @param request_handler Any exception thrown by the invocation of the request handler will be rethrown by
  * GrpcContext#run(). Except for the sender version, where the exception will be send to the receiver.
  * @param token The completion signature is `void()`. If the token has been created by `agrpc::use_sender` then the
@@ -83,9 +91,9 @@ class RepeatedlyRequestFn
         if constexpr (detail::INVOKE_RESULT_IS_CO_SPAWNABLE<std::decay_t<RequestHandler>&,
                                                             typename RPCContext::Signature>)
         {
-            return asio::async_initiate<CompletionToken, void()>(detail::RepeatedlyRequestAwaitableInitiator{}, token,
-                                                                 std::forward<RequestHandler>(request_handler), rpc,
-                                                                 service);
+            return asio::async_initiate<CompletionToken, void()>(
+                detail::RepeatedlyRequestAwaitableInitiator<agrpc::RepeatedlyRequestOptions>{}, token,
+                std::forward<RequestHandler>(request_handler), rpc, service, agrpc::RepeatedlyRequestOptions{});
         }
         else
 #endif
@@ -95,6 +103,28 @@ class RepeatedlyRequestFn
                                                                  service);
         }
     }
+
+    template <class RPC, class Service, class Options, class RequestHandler, class CompletionToken>
+    static auto impl(RPC rpc, Service& service, const Options& options, RequestHandler&& request_handler,
+                     CompletionToken token)
+    {
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+        using RPCContext = detail::RPCContextForRPCT<RPC>;
+        if constexpr (detail::INVOKE_RESULT_IS_CO_SPAWNABLE<std::decay_t<RequestHandler>&,
+                                                            typename RPCContext::Signature>)
+        {
+            return asio::async_initiate<CompletionToken, void()>(
+                detail::RepeatedlyRequestAwaitableInitiator<Options>{}, token,
+                std::forward<RequestHandler>(request_handler), rpc, service, options);
+        }
+        else
+#endif
+        {
+            return asio::async_initiate<CompletionToken, void()>(
+                detail::RepeatedlyRequestWithOptionsInitiator<Options>{}, token,
+                std::forward<RequestHandler>(request_handler), rpc, service, options);
+        }
+    }
 #endif
 
     template <class RPC, class Service, class RequestHandler>
@@ -104,12 +134,19 @@ class RepeatedlyRequestFn
                                                std::forward<RequestHandler>(request_handler)};
     }
 
+    template <class RPC, class Service, class Options, class RequestHandler>
+    static void impl(RPC, Service&, const Options&, RequestHandler&&, detail::UseSender)
+    {
+        static_assert(sizeof(Options) == 0, "agrpc::use_sender does not support repeatedly_request options");
+    }
+
   public:
     /**
      * @brief Overload for unary and server-streaming RPCs
      */
     template <class RPC, class Service, class Request, class Responder, class RequestHandler,
-              class CompletionToken = detail::NoOp>
+              class CompletionToken = detail::NoOp,
+              std::enable_if_t<!detail::IS_REPEATEDLY_REQUEST_OPTIONS<RequestHandler>>* = nullptr>
     auto operator()(detail::ServerMultiArgRequest<RPC, Request, Responder> rpc, Service& service,
                     RequestHandler&& request_handler, CompletionToken&& token = {}) const
     {
@@ -120,13 +157,76 @@ class RepeatedlyRequestFn
     /**
      * @brief Overload for client-streaming and bidirectional RPCs
      */
-    template <class RPC, class Service, class Responder, class RequestHandler, class CompletionToken = detail::NoOp>
+    template <class RPC, class Service, class Responder, class RequestHandler, class CompletionToken = detail::NoOp,
+              std::enable_if_t<!detail::IS_REPEATEDLY_REQUEST_OPTIONS<RequestHandler>>* = nullptr>
     auto operator()(detail::ServerSingleArgRequest<RPC, Responder> rpc, Service& service,
                     RequestHandler&& request_handler, CompletionToken&& token = {}) const
     {
         return RepeatedlyRequestFn::impl(rpc, service, std::forward<RequestHandler>(request_handler),
                                          std::forward<CompletionToken>(token));
     }
+
+    /**
+     * @brief (experimental) Overload for unary and server-streaming RPCs with options
+     *
+     * @since 1.6.0
+     */
+    template <class RPC, class Service, class Request, class Responder, class RequestHandler,
+              class CompletionToken = detail::NoOp>
+    auto operator()(detail::ServerMultiArgRequest<RPC, Request, Responder> rpc, Service& service,
+                    agrpc::RepeatedlyRequestOptions options, RequestHandler&& request_handler,
+                    CompletionToken&& token = {}) const
+    {
+        return RepeatedlyRequestFn::impl(rpc, service, options, std::forward<RequestHandler>(request_handler),
+                                         std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief (experimental) Overload for client-streaming and bidirectional RPCs with options
+     *
+     * @since 1.6.0
+     */
+    template <class RPC, class Service, class Responder, class RequestHandler, class CompletionToken = detail::NoOp>
+    auto operator()(detail::ServerSingleArgRequest<RPC, Responder> rpc, Service& service,
+                    agrpc::RepeatedlyRequestOptions options, RequestHandler&& request_handler,
+                    CompletionToken&& token = {}) const
+    {
+        return RepeatedlyRequestFn::impl(rpc, service, options, std::forward<RequestHandler>(request_handler),
+                                         std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief (experimental) Overload for unary and server-streaming RPCs with arena options
+     *
+     * Requires `agrpc/repeatedlyRequestArenaOptions.hpp` to be included.
+     *
+     * @since 1.6.0
+     */
+    template <class RPC, class Service, class Request, class Responder, class RequestHandler,
+              class CompletionToken = detail::NoOp>
+    auto operator()(detail::ServerMultiArgRequest<RPC, Request, Responder> rpc, Service& service,
+                    const agrpc::RepeatedlyRequestArenaOptions& options, RequestHandler&& request_handler,
+                    CompletionToken&& token = {}) const
+    {
+        return RepeatedlyRequestFn::impl(rpc, service, options, std::forward<RequestHandler>(request_handler),
+                                         std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief (experimental) Overload for client-streaming and bidirectional RPCs with arena options
+     *
+     * Requires `agrpc/repeatedlyRequestArenaOptions.hpp` to be included.
+     *
+     * @since 1.6.0
+     */
+    template <class RPC, class Service, class Responder, class RequestHandler, class CompletionToken = detail::NoOp>
+    auto operator()(detail::ServerSingleArgRequest<RPC, Responder> rpc, Service& service,
+                    const agrpc::RepeatedlyRequestArenaOptions& options, RequestHandler&& request_handler,
+                    CompletionToken&& token = {}) const
+    {
+        return RepeatedlyRequestFn::impl(rpc, service, options, std::forward<RequestHandler>(request_handler),
+                                         std::forward<CompletionToken>(token));
+    }
 };
 }  // namespace detail
 
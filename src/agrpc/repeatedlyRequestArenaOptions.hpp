@@ -0,0 +1,54 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_REPEATEDLYREQUESTARENAOPTIONS_HPP
+#define AGRPC_AGRPC_REPEATEDLYREQUESTARENAOPTIONS_HPP
+
+#include "agrpc/detail/arenaRPCContext.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/rpcContext.hpp"
+#include "agrpc/repeatedlyRequestOptions.hpp"
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Options for repeatedly_request that place request messages on a protobuf Arena
+ *
+ * Every RPC context owns a `google::protobuf::Arena` on which the request message is created. The arena is available
+ * to the request handler through `agrpc::RepeatedlyRequestContext::arena()`, e.g. to create the response message on
+ * it as well. When the RPC context is recycled (see `max_recycled_rpc_contexts`) then the arena is `Reset()`, which
+ * destroys all messages that were created on it while retaining its memory blocks for the next RPC. Awaitable request
+ * handlers receive the request message that has been created on the arena but have no access to the arena itself.
+ *
+ * Request messages must be protobuf messages. This header is not included by `agrpc/asioGrpc.hpp` so that only users
+ * of these options depend on `google/protobuf/arena.h`.
+ *
+ * @since 1.6.0
+ */
+struct RepeatedlyRequestArenaOptions : agrpc::RepeatedlyRequestOptions
+{
+};
+
+namespace detail
+{
+template <class RPC>
+struct RPCContextForOptions<agrpc::RepeatedlyRequestArenaOptions, RPC>
+{
+    using Type = detail::ArenaRPCContextForRPCT<RPC>;
+};
+}
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_REPEATEDLYREQUESTARENAOPTIONS_HPP
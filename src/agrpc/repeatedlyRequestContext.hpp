@@ -28,6 +28,12 @@ inline constexpr bool HAS_REQUEST_MEMBER_FUNCTION = false;
 
 template <class T>
 inline constexpr bool HAS_REQUEST_MEMBER_FUNCTION<T, std::void_t<decltype(std::declval<T&>()->request())>> = true;
+
+template <class, class = void>
+inline constexpr bool HAS_ARENA_MEMBER_FUNCTION = false;
+
+template <class T>
+inline constexpr bool HAS_ARENA_MEMBER_FUNCTION<T, std::void_t<decltype(std::declval<T&>()->arena())>> = true;
 }
 
 /**
@@ -84,6 +90,22 @@ class RepeatedlyRequestContext
      */
     [[nodiscard]] decltype(auto) responder() const noexcept { return impl->responder(); }
 
+    /**
+     * @brief (experimental) Reference to the `google::protobuf::Arena` of this request
+     *
+     * Only available if repeatedly_request has been called with `agrpc::RepeatedlyRequestArenaOptions`, see
+     * `agrpc/repeatedlyRequestArenaOptions.hpp`. The request message has been created on this arena.
+     *
+     * @since 1.6.0
+     */
+    [[nodiscard]] decltype(auto) arena() const noexcept
+    {
+        static_assert(detail::HAS_ARENA_MEMBER_FUNCTION<detail::AllocatedPointer<ImplementationAllocator>>,
+                      "The .arena() member function is only available when using "
+                      "agrpc::RepeatedlyRequestArenaOptions.");
+        return impl->arena();
+    }
+
   private:
     friend detail::RepeatedlyRequestContextAccess;
 
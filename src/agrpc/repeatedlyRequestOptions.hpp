@@ -0,0 +1,118 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_REPEATEDLYREQUESTOPTIONS_HPP
+#define AGRPC_AGRPC_REPEATEDLYREQUESTOPTIONS_HPP
+
+#include "agrpc/detail/config.hpp"
+
+#include <cstddef>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Admission policy for repeatedly_request
+ *
+ * RPCs that are not admitted are finished immediately with `grpc::StatusCode::RESOURCE_EXHAUSTED`, without invoking
+ * the request handler. Every limit is disabled when set to zero. An RPC is admitted only if it satisfies all enabled
+ * limits.
+ *
+ * @since 1.6.0
+ */
+struct RepeatedlyRequestAdmissionPolicy
+{
+    /**
+     * @brief Reject RPCs while this many RPCs are being processed by the request handler
+     *
+     * See `agrpc::RepeatedlyRequestOptions::max_in_flight_handlers` for what counts as being processed.
+     */
+    std::size_t max_in_flight_handlers{};
+
+    /**
+     * @brief Reject RPCs while the GrpcContext has at least this much outstanding work
+     *
+     * Outstanding work includes every pending operation of the GrpcContext, e.g. alarms, client calls and the
+     * outstanding requests of all repeatedly_request registrations.
+     */
+    long max_outstanding_work{};
+
+    /**
+     * @brief Average number of RPCs that are admitted per second
+     *
+     * Implemented as a token bucket that is refilled at this rate and holds up to `burst_size` tokens.
+     */
+    double requests_per_second{};
+
+    /**
+     * @brief Capacity of the token bucket, values less than one are treated as one
+     */
+    std::size_t burst_size{1};
+};
+
+/**
+ * @brief (experimental) Options for repeatedly_request
+ *
+ * The options apply to callback and awaitable request handlers. They cannot be used together with
+ * `agrpc::use_sender`.
+ *
+ * @since 1.6.0
+ */
+struct RepeatedlyRequestOptions
+{
+    /**
+     * @brief Maximum number of RPC contexts that are kept for reuse
+     *
+     * When greater than zero, the `grpc::ServerContext`, request message and responder of a finished request are not
+     * deallocated. Instead they are returned to a free-list that belongs to this registration and used for one of
+     * the next requests. The request message is `Clear()`ed rather than reconstructed, retaining the memory it owns.
+     * The `grpc::ServerContext` and the responder are reconstructed in place, since gRPC does not allow them to be
+     * reused. RPC contexts in excess of this number are deallocated as usual.
+     */
+    std::size_t max_recycled_rpc_contexts{};
+
+    /**
+     * @brief Number of requests that are kept outstanding at the same time
+     *
+     * Every outstanding request allows gRPC to hand a new RPC to the request handler without waiting for the previous
+     * RPC to be re-requested, which helps absorbing bursts of incoming RPCs. Values less than one are treated as one.
+     */
+    std::size_t outstanding_requests{1};
+
+    /**
+     * @brief Maximum number of RPCs that are being processed by the request handler at the same time
+     *
+     * An RPC is being processed from the invocation of the request handler until its `agrpc::RepeatedlyRequestContext`
+     * is destructed or, for awaitable request handlers, until the returned awaitable has completed. When this limit is
+     * reached then finished requests are not re-requested until one of the RPCs has finished processing, applying
+     * backpressure onto gRPC. Requests that are already outstanding are still handed to the request handler, the limit
+     * can therefore be exceeded by up to `outstanding_requests - 1`. Zero means unlimited.
+     *
+     * @attention Cancellation of repeatedly_request takes effect only after the number of RPCs that are being
+     * processed has dropped below this limit.
+     */
+    std::size_t max_in_flight_handlers{};
+
+    /**
+     * @brief Policy for shedding load by rejecting RPCs
+     *
+     * Unlike `max_in_flight_handlers`, which stops accepting RPCs from gRPC, the admission policy accepts every RPC
+     * and rejects the ones exceeding its limits at the cost of a single `FinishWithError`. The request that was used to
+     * reject the RPC is re-requested once the rejection has completed.
+     */
+    agrpc::RepeatedlyRequestAdmissionPolicy admission_policy{};
+};
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_REPEATEDLYREQUESTOPTIONS_HPP
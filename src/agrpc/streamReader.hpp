@@ -0,0 +1,332 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_STREAMREADER_HPP
+#define AGRPC_AGRPC_STREAMREADER_HPP
+
+#include "agrpc/defaultCompletionToken.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/grpcContextImplementation.hpp"
+#include "agrpc/detail/grpcInitiate.hpp"
+#include "agrpc/detail/streamReader.hpp"
+#include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Read from a stream while the previous messages are being processed
+ *
+ * gRPC permits only one outstanding read per stream. Calling `agrpc::read` in a loop therefore alternates between
+ * waiting for the network and processing a message. A StreamReader keeps a read in flight into a ring of `Capacity`
+ * message objects while the caller processes the messages that have already arrived. The message objects are
+ * allocated once, as part of the StreamReader, and reused for the lifetime of the stream.
+ *
+ * Example:
+ *
+ * @code{cpp}
+ * agrpc::StreamReader<grpc::ServerAsyncReader<Response, Request>, 4> reader{responder};
+ * while (co_await reader.next(asio::use_awaitable))
+ * {
+ *     process(reader.message());
+ * }
+ * @endcode
+ *
+ * A message obtained through `message()` remains valid until the next call to `next()`, after which its slot is reused
+ * for a subsequent read. When all slots are occupied by messages that have not been consumed yet, no further read is
+ * started until `next()` is called again. That bounds the amount of memory that a fast producer can make the reader
+ * hold on to.
+ *
+ * The first read is started by the first call to `next()`. This class is not thread-safe: `next()` must be called from
+ * the thread that runs the GrpcContext and only one `next()` or `drain()` may be outstanding at a time. The StreamReader
+ * must not be destroyed while a read is in flight, see `is_reading()`. A read that has been started always completes,
+ * at the latest when the RPC is finished or cancelled. To stop reading before the stream has ended, for example to
+ * break out of the loop above, wait for `drain()` before destroying the StreamReader:
+ *
+ * @code{cpp}
+ * while (co_await reader.next(asio::use_awaitable))
+ * {
+ *     if (!process(reader.message()))
+ *     {
+ *         break;
+ *     }
+ * }
+ * co_await reader.drain(asio::use_awaitable);
+ * @endcode
+ *
+ * @tparam Responder One of `grpc::ServerAsyncReader`, `grpc::ServerAsyncReaderWriter`, `grpc::ClientAsyncReader` or
+ * `grpc::ClientAsyncReaderWriter`
+ * @tparam Capacity The number of message objects. With a capacity of one, a read is only started by `next()` and
+ * the behavior is equivalent to `agrpc::read`.
+ *
+ * @since 1.6.0
+ */
+template <class Responder, std::size_t Capacity = 2>
+class StreamReader
+{
+  private:
+    static_assert(Capacity > 0, "StreamReader must have a non-zero capacity");
+
+  public:
+    /**
+     * @brief The type of message that is read from the stream
+     */
+    using message_type = detail::StreamReaderMessageT<Responder>;
+
+    /**
+     * @brief The number of message objects
+     */
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    /**
+     * @brief Construct from a responder
+     *
+     * @param responder Must remain valid for the lifetime of this object.
+     */
+    explicit StreamReader(Responder& responder) : responder(responder), read_operation(*this), ready_operation(*this) {}
+
+    StreamReader(const StreamReader&) = delete;
+    StreamReader(StreamReader&&) = delete;
+    StreamReader& operator=(const StreamReader&) = delete;
+    StreamReader& operator=(StreamReader&&) = delete;
+
+    /**
+     * @brief Wait for the next message
+     *
+     * Releases the message that was obtained from the previous call, starts a read if a slot is available and none is
+     * in flight yet, and completes as soon as a message is ready. Completes without waiting if a message has been
+     * read ahead.
+     *
+     * @param token A completion token like `asio::yield_context` or the one created by `agrpc::use_sender`. The
+     * completion signature is `void(bool)`. `true` indicates that `message()` refers to the next message. `false` when
+     * there will be no more messages, either because the other side has finished writing or the stream has failed (or
+     * been cancelled).
+     */
+    template <class CompletionToken = agrpc::DefaultCompletionToken>
+    auto next(CompletionToken&& token = {}) noexcept(
+        detail::IS_NOTRHOW_GRPC_INITIATE_COMPLETION_TOKEN<CompletionToken>)
+    {
+        return detail::grpc_initiate(detail::StreamReaderNextInitFunction<StreamReader>{*this},
+                                     std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief Wait for the read that is in flight
+     *
+     * Completes once no read is in flight anymore, without starting a new one, after which the StreamReader may be
+     * destroyed. Completes without waiting if no read is in flight. Messages that have been read ahead remain available
+     * through subsequent calls to `next()`, which also resumes reading ahead. The message obtained by the last `next()`
+     * remains valid.
+     *
+     * @param token A completion token like `asio::yield_context` or the one created by `agrpc::use_sender`. The
+     * completion signature is `void(bool)`. `true` when further messages can be obtained through `next()`.
+     */
+    template <class CompletionToken = agrpc::DefaultCompletionToken>
+    auto drain(CompletionToken&& token = {}) noexcept(
+        detail::IS_NOTRHOW_GRPC_INITIATE_COMPLETION_TOKEN<CompletionToken>)
+    {
+        return detail::grpc_initiate(detail::StreamReaderDrainInitFunction<StreamReader>{*this},
+                                     std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief The message that was obtained by the last successful `next()`
+     */
+    [[nodiscard]] message_type& message() noexcept
+    {
+        assert(lent);
+        return messages[head];
+    }
+
+    /**
+     * @brief The number of messages that have been read ahead and not yet been obtained through `next()`
+     */
+    [[nodiscard]] std::size_t ready_count() const noexcept { return ready; }
+
+    /**
+     * @brief Whether a read is in flight
+     */
+    [[nodiscard]] bool is_reading() const noexcept { return reading; }
+
+  private:
+    friend detail::StreamReaderAccess;
+
+    struct ReadOperation : detail::TypeErasedGrpcTagOperation
+    {
+        explicit ReadOperation(StreamReader& self) noexcept
+            : detail::TypeErasedGrpcTagOperation(&StreamReader::on_read_complete), self(self)
+        {
+        }
+
+        StreamReader& self;
+    };
+
+    // Completes a next() for which a message has already been read ahead
+    struct ReadyOperation : detail::TypeErasedNoArgOperation
+    {
+        explicit ReadyOperation(StreamReader& self) noexcept
+            : detail::TypeErasedNoArgOperation(&StreamReader::on_ready), self(self)
+        {
+        }
+
+        StreamReader& self;
+        detail::TypeErasedGrpcTagOperation* tag{};
+    };
+
+    // The tag of next() carries one unit of outstanding work. It is either parked as the waiter and completed from
+    // on_read_complete or handed to the ready operation, which the GrpcContext accounts for like any other posted
+    // operation.
+    void initiate_next(agrpc::GrpcContext& context, detail::TypeErasedGrpcTagOperation* tag)
+    {
+        assert(!waiter && !ready_operation.tag);
+        grpc_context = &context;
+        if (lent)
+        {
+            lent = false;
+            head = (head + 1) % Capacity;
+        }
+        this->initiate_read();
+        if (ready == 0 && !finished)
+        {
+            waiter = tag;
+            return;
+        }
+        this->add_ready_operation(context, tag);
+    }
+
+    // The tag of drain() is completed through the same paths as the one of next(), but neither consumes a message nor
+    // lets on_read_complete start another read
+    void initiate_drain(agrpc::GrpcContext& context, detail::TypeErasedGrpcTagOperation* tag)
+    {
+        assert(!waiter && !ready_operation.tag);
+        grpc_context = &context;
+        draining = true;
+        if (reading)
+        {
+            waiter = tag;
+            return;
+        }
+        this->add_ready_operation(context, tag);
+    }
+
+    void add_ready_operation(agrpc::GrpcContext& context, detail::TypeErasedGrpcTagOperation* tag)
+    {
+        ready_operation.tag = tag;
+        if (detail::GrpcContextImplementation::running_in_this_thread(context))
+        {
+            detail::GrpcContextImplementation::add_local_operation(context, &ready_operation);
+        }
+        else
+        {
+            detail::GrpcContextImplementation::add_remote_operation(context, &ready_operation);
+        }
+    }
+
+    void initiate_read()
+    {
+        const auto occupied = static_cast<std::size_t>(lent) + ready;
+        if (reading || finished || draining || occupied == Capacity)
+        {
+            return;
+        }
+        reading = true;
+        grpc_context->work_started();
+        read_operation.set_operation_type(agrpc::OperationType::READ);
+        responder.Read(&messages[(head + occupied) % Capacity], &read_operation);
+    }
+
+    void complete(detail::TypeErasedGrpcTagOperation* tag, detail::InvokeHandler invoke_handler,
+                  detail::GrpcContextLocalAllocator allocator)
+    {
+        if (draining)
+        {
+            draining = false;
+            // Might destroy this object
+            tag->complete(invoke_handler, ready != 0 || !finished, allocator);
+            return;
+        }
+        const auto has_message = ready != 0;
+        if (has_message)
+        {
+            --ready;
+            lent = true;
+        }
+        // Might destroy this object
+        tag->complete(invoke_handler, has_message, allocator);
+    }
+
+    static void on_read_complete(detail::TypeErasedGrpcTagOperation* op, detail::InvokeHandler invoke_handler,
+                                 bool ok, detail::GrpcContextLocalAllocator allocator)
+    {
+        auto& self = static_cast<ReadOperation*>(op)->self;
+        self.reading = false;
+        if AGRPC_LIKELY (ok)
+        {
+            ++self.ready;
+        }
+        else
+        {
+            self.finished = true;
+        }
+        if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+        {
+            self.initiate_read();
+        }
+        if (self.waiter)
+        {
+            detail::WorkFinishedOnExit on_exit{*self.grpc_context};
+            self.complete(std::exchange(self.waiter, nullptr), invoke_handler, allocator);
+        }
+    }
+
+    static void on_ready(detail::TypeErasedNoArgOperation* op, detail::InvokeHandler invoke_handler,
+                         detail::GrpcContextLocalAllocator allocator)
+    {
+        auto& ready_operation = *static_cast<ReadyOperation*>(op);
+        auto& self = ready_operation.self;
+        auto* tag = std::exchange(ready_operation.tag, nullptr);
+        if AGRPC_UNLIKELY (detail::InvokeHandler::NO == invoke_handler && self.reading)
+        {
+            // The GrpcContext is shutting down and destroying the tag might destroy this object, let the read
+            // operation do it instead
+            self.grpc_context->work_started();
+            self.waiter = tag;
+            return;
+        }
+        self.complete(tag, invoke_handler, allocator);
+    }
+
+    Responder& responder;
+    agrpc::GrpcContext* grpc_context{};
+    detail::TypeErasedGrpcTagOperation* waiter{};
+    ReadOperation read_operation;
+    ReadyOperation ready_operation;
+    std::size_t head{};
+    std::size_t ready{};
+    bool lent{};
+    bool reading{};
+    bool draining{};
+    bool finished{};
+    std::array<message_type, Capacity> messages{};
+};
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_STREAMREADER_HPP
@@ -0,0 +1,122 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_UNARYCALL_HPP
+#define AGRPC_AGRPC_UNARYCALL_HPP
+
+#include "agrpc/defaultCompletionToken.hpp"
+#include "agrpc/detail/asioForward.hpp"
+#include "agrpc/detail/config.hpp"
+#include "agrpc/detail/unaryCall.hpp"
+#include "agrpc/detail/useSender.hpp"
+
+AGRPC_NAMESPACE_BEGIN()
+
+namespace detail
+{
+/**
+ * @brief (experimental) Client-side function object to perform unary RPCs
+ *
+ * @attention The completion handler created from the completion token that is provided to the functions described below
+ * must have an associated executor that refers to a GrpcContext:
+ * @snippet server.cpp bind-executor-to-use-awaitable
+ *
+ * @since 1.6.0
+ */
+struct UnaryCallFn
+{
+  private:
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+    template <class Stub, class Request, class Response, class CompletionToken>
+    static auto impl(detail::ClientUnaryCallInitFunction<Stub, Request, Response> init_function, CompletionToken token)
+    {
+        using InitFunction = detail::ClientUnaryCallInitFunction<Stub, Request, Response>;
+#ifdef AGRPC_ASIO_HAS_CO_AWAIT
+        if constexpr (detail::IS_USE_AWAITABLE<CompletionToken>)
+        {
+            return asio::async_initiate<CompletionToken, void(grpc::Status)>(
+                detail::UnaryCallAwaitableInitiator<Response, InitFunction>{init_function}, token);
+        }
+        else
+#endif
+        {
+            return asio::async_initiate<CompletionToken, void(grpc::Status)>(
+                detail::UnaryCallInitiator<Response, detail::GrpcInitiator<InitFunction>>{init_function}, token);
+        }
+    }
+#endif
+
+    template <class Stub, class Request, class Response>
+    static auto impl(detail::ClientUnaryCallInitFunction<Stub, Request, Response> init_function,
+                     detail::UseSender token) noexcept
+    {
+        return detail::UnaryCallSender<Stub, Request, Response>{token.grpc_context, init_function};
+    }
+
+  public:
+    /**
+     * @brief Perform a unary RPC
+     *
+     * Starts the RPC and waits for the server's response and final status in a single operation. The
+     * `grpc::ClientAsyncResponseReader` is created by gRPC on the arena of the call and, together with the
+     * `grpc::Status`, stored inside the operation. That operation is allocated through the completion handler's
+     * associated allocator, which defaults to the memory pool of the GrpcContext. Once that pool has warmed up, a call
+     * therefore does not allocate any memory beyond what gRPC needs for the call itself. For `agrpc::use_sender` the
+     * operation is not allocated at all, it lives in the operation state. The same applies to `asio::use_awaitable` with
+     * Boost 1.74 to 1.78 or standalone Asio 1.17 to 1.22, where the operation lives in the coroutine frame.
+     *
+     * Example:
+     *
+     * @code{cpp}
+     * grpc::ClientContext client_context;
+     * example::v1::Response response;
+     * const grpc::Status status = co_await agrpc::unary_call(&example::v1::Example::Stub::PrepareAsyncUnary, stub,
+     *                                                        client_context, request, response);
+     * @endcode
+     *
+     * @param rpc A pointer to the PrepareAsync version of the RPC method, it always starts with `PrepareAsync`.
+     * @param stub The Stub that corresponds to the RPC method. In the example above the stub is:
+     * `example::v1::Example::Stub`.
+     * @param client_context Must remain valid until the operation has completed.
+     * @param request Must remain valid until the operation has completed.
+     * @param response Must remain valid until the operation has completed.
+     * @param token A completion token like `asio::yield_context` or the one created by `agrpc::use_sender`. The
+     * completion signature is `void(grpc::Status)`.
+     */
+    template <class Stub, class Request, class Response, class CompletionToken = agrpc::DefaultCompletionToken>
+    auto operator()(detail::ClientUnaryRequest<Stub, Request, Response> rpc, Stub& stub,
+                    grpc::ClientContext& client_context, const Request& request, Response& response,
+                    CompletionToken&& token = {}) const
+    {
+        return UnaryCallFn::impl(detail::ClientUnaryCallInitFunction<Stub, Request, Response>{
+                                     rpc, stub, client_context, request, response},
+                                 std::forward<CompletionToken>(token));
+    }
+};
+}
+
+/**
+ * @brief (experimental) Perform a unary RPC
+ *
+ * @link detail::UnaryCallFn
+ * Client-side function to perform unary RPCs.
+ * @endlink
+ *
+ * @since 1.6.0
+ */
+inline constexpr detail::UnaryCallFn unary_call{};
+
+AGRPC_NAMESPACE_END
+
+#endif  // AGRPC_AGRPC_UNARYCALL_HPP
@@ -0,0 +1,285 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_AGRPC_WRITEQUEUE_HPP
+#define AGRPC_AGRPC_WRITEQUEUE_HPP
+
+#include "agrpc/defaultCompletionToken.hpp"
+#include "agrpc/detail/asioForward.hpp"
+#include "agrpc/detail/config.hpp"
+
+#if defined(AGRPC_STANDALONE_ASIO) || defined(AGRPC_BOOST_ASIO)
+#include "agrpc/detail/atomicIntrusiveQueue.hpp"
+#include "agrpc/detail/grpcContextImplementation.hpp"
+#include "agrpc/detail/intrusiveQueue.hpp"
+#include "agrpc/detail/rpc.hpp"
+#include "agrpc/detail/typeErasedOperation.hpp"
+#include "agrpc/detail/writeQueue.hpp"
+#include "agrpc/grpcContext.hpp"
+#include "agrpc/operationType.hpp"
+
+#include <utility>
+
+AGRPC_NAMESPACE_BEGIN()
+
+/**
+ * @brief (experimental) Thread-safe queue of messages to write to a stream
+ *
+ * gRPC permits only one outstanding write per stream. Producing messages from several threads or coroutines therefore
+ * requires funneling them through a single writer, e.g. a channel and a coroutine that writes what it receives. A
+ * WriteQueue accepts `write()`s from any thread and issues them to the stream one after another on its GrpcContext.
+ * While a write is in flight, further messages are queued and the next one is written directly from the completion of
+ * the previous write, without another round-trip through the GrpcContext per message.
+ *
+ * Example:
+ *
+ * @code{cpp}
+ * agrpc::WriteQueue<grpc::ServerAsyncReaderWriter<Response, Request>> write_queue{grpc_context, reader_writer};
+ * // From any thread, e.g. a coroutine that has been switched to an asio::thread_pool:
+ * co_await write_queue.write(response, asio::use_awaitable);
+ * // Once all writes have been initiated:
+ * const bool ok = co_await write_queue.flush(asio::use_awaitable);
+ * co_await agrpc::finish(reader_writer, grpc::Status::OK, asio::use_awaitable);
+ * @endcode
+ *
+ * The completion handler of a `write()` is invoked as soon as its message has been handed to gRPC, which serializes it
+ * right away. The outcome of that write is reported to subsequent `write()`s and `flush()`es. Queued entries are
+ * processed in the order in which their operations were initiated. Each entry is stored inside the operation that is
+ * allocated for its completion handler, the queue itself does not allocate.
+ *
+ * Writes are not coalesced: every message is issued as its own `Write` without `grpc::WriteOptions::set_buffer_hint()`,
+ * since a write with that hint does not complete before gRPC decides to flush it, which would stall the queue. Batching
+ * messages into frames is left to gRPC.
+ *
+ * The WriteQueue must not be destroyed before all `write()`s have completed and a final `flush()` has completed. It
+ * must not be used concurrently with other writes to the same stream.
+ *
+ * @attention The completion handler created from the completion token that is provided to the functions described below
+ * must have an associated executor that refers to the GrpcContext that this WriteQueue was constructed with.
+ *
+ * @tparam Responder One of `grpc::ServerAsyncWriter`, `grpc::ServerAsyncReaderWriter`, `grpc::ClientAsyncWriter` or
+ * `grpc::ClientAsyncReaderWriter`
+ *
+ * @since 1.6.0
+ */
+template <class Responder>
+class WriteQueue
+{
+  public:
+    /**
+     * @brief The type of message that is written to the stream
+     */
+    using message_type = detail::StreamWriterMessageT<Responder>;
+
+    /**
+     * @brief Construct from a GrpcContext and a responder
+     *
+     * @param grpc_context The GrpcContext on which writes are issued and completed. Must outlive this object.
+     * @param responder Must remain valid for the lifetime of this object.
+     */
+    WriteQueue(agrpc::GrpcContext& grpc_context, Responder& responder)
+        : grpc_context(grpc_context), responder(responder), write_operation(*this), drain_operation(*this)
+    {
+    }
+
+    WriteQueue(const WriteQueue&) = delete;
+    WriteQueue(WriteQueue&&) = delete;
+    WriteQueue& operator=(const WriteQueue&) = delete;
+    WriteQueue& operator=(WriteQueue&&) = delete;
+
+    /**
+     * @brief Queue a message
+     *
+     * Thread-safe. Completes once the message has been handed to gRPC, which happens as soon as the writes that have
+     * been queued before it have been issued and the previous write has completed.
+     *
+     * @param message Must remain valid until the operation has completed.
+     * @param token A completion token like `asio::yield_context`. The completion signature is `void(bool)`. `false` if
+     * a previous write has failed, in which case the message has been discarded and the stream is broken.
+     */
+    template <class CompletionToken = agrpc::DefaultCompletionToken>
+    auto write(const message_type& message, CompletionToken&& token = {})
+    {
+        return this->initiate(&message, std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * @brief Wait until all messages that have been queued before have been written
+     *
+     * Thread-safe.
+     *
+     * @param token A completion token like `asio::yield_context`. The completion signature is `void(bool)`. `true`
+     * if all writes have succeeded.
+     */
+    template <class CompletionToken = agrpc::DefaultCompletionToken>
+    auto flush(CompletionToken&& token = {})
+    {
+        return this->initiate(nullptr, std::forward<CompletionToken>(token));
+    }
+
+  private:
+    friend detail::WriteQueueAccess;
+
+    using Entry = detail::WriteQueueEntry<message_type>;
+
+    struct WriteOperation : detail::TypeErasedGrpcTagOperation
+    {
+        explicit WriteOperation(WriteQueue& self) noexcept
+            : detail::TypeErasedGrpcTagOperation(&WriteQueue::on_write_complete), self(self)
+        {
+        }
+
+        WriteQueue& self;
+    };
+
+    // Processes the queue after it has been idle or after an entry has been completed without writing
+    struct DrainOperation : detail::TypeErasedNoArgOperation
+    {
+        explicit DrainOperation(WriteQueue& self) noexcept
+            : detail::TypeErasedNoArgOperation(&WriteQueue::on_drain), self(self)
+        {
+        }
+
+        WriteQueue& self;
+    };
+
+    template <class CompletionToken>
+    auto initiate(const message_type* message, CompletionToken&& token)
+    {
+        using InitFunction = detail::WriteQueueInitFunction<WriteQueue>;
+        using Initiator = detail::WriteQueueInitiator<message_type, InitFunction>;
+        return asio::async_initiate<CompletionToken, void(bool)>(Initiator{InitFunction{*this, message}}, token);
+    }
+
+    // Called from the thread that initiates write() or flush(). Each entry carries the unit of outstanding work of its
+    // operation. All other members are only accessed by the drain and write operations, which never run concurrently.
+    void enqueue(Entry& entry)
+    {
+        if (incoming.enqueue(&entry))
+        {
+            this->post_drain();
+        }
+    }
+
+    void post_drain()
+    {
+        grpc_context.work_started();
+        if (detail::GrpcContextImplementation::running_in_this_thread(grpc_context))
+        {
+            detail::GrpcContextImplementation::add_local_operation(grpc_context, &drain_operation);
+        }
+        else
+        {
+            detail::GrpcContextImplementation::add_remote_operation(grpc_context, &drain_operation);
+        }
+    }
+
+    // Returns nullptr after marking the queue idle, from then on other threads may post the drain operation
+    Entry* next_entry() noexcept
+    {
+        if (pending.empty())
+        {
+            pending = incoming.try_mark_inactive_or_dequeue_all();
+            if (pending.empty())
+            {
+                return nullptr;
+            }
+        }
+        return pending.pop_front();
+    }
+
+    void write_next(detail::InvokeHandler invoke_handler, detail::GrpcContextLocalAllocator allocator)
+    {
+        auto* entry = this->next_entry();
+        if (entry == nullptr)
+        {
+            return;
+        }
+        const bool ok = !failed;
+        auto& context = grpc_context;
+        if (entry->message != nullptr && ok)
+        {
+            context.work_started();
+            write_operation.set_operation_type(agrpc::OperationType::WRITE);
+            responder.Write(*entry->message, &write_operation);
+        }
+        else if (!pending.empty() || !incoming.try_mark_inactive())
+        {
+            // A flush() or a write() after a failure, continue with the next entry afterwards
+            this->post_drain();
+        }
+        // Might destroy this object
+        detail::WorkFinishedOnExit on_exit{context};
+        entry->tag->complete(invoke_handler, ok, allocator);
+    }
+
+    // The GrpcContext is shutting down. Destroying an entry might destroy this object.
+    void destroy_entries(detail::GrpcContextLocalAllocator allocator)
+    {
+        auto entries = std::exchange(pending, {});
+        entries.append(incoming.dequeue_all());
+        auto& context = grpc_context;
+        while (!entries.empty())
+        {
+            auto* entry = entries.pop_front();
+            detail::WorkFinishedOnExit on_exit{context};
+            entry->tag->complete(detail::InvokeHandler::NO, false, allocator);
+        }
+    }
+
+    static void on_write_complete(detail::TypeErasedGrpcTagOperation* op, detail::InvokeHandler invoke_handler,
+                                  bool ok, detail::GrpcContextLocalAllocator allocator)
+    {
+        auto& self = static_cast<WriteOperation*>(op)->self;
+        if AGRPC_UNLIKELY (!ok)
+        {
+            self.failed = true;
+        }
+        if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+        {
+            self.write_next(invoke_handler, allocator);
+        }
+        else
+        {
+            self.destroy_entries(allocator);
+        }
+    }
+
+    static void on_drain(detail::TypeErasedNoArgOperation* op, detail::InvokeHandler invoke_handler,
+                         detail::GrpcContextLocalAllocator allocator)
+    {
+        auto& self = static_cast<DrainOperation*>(op)->self;
+        if AGRPC_LIKELY (detail::InvokeHandler::YES == invoke_handler)
+        {
+            self.write_next(invoke_handler, allocator);
+        }
+        else
+        {
+            self.destroy_entries(allocator);
+        }
+    }
+
+    agrpc::GrpcContext& grpc_context;
+    Responder& responder;
+    detail::AtomicIntrusiveQueue<Entry> incoming{false};
+    detail::IntrusiveQueue<Entry> pending;
+    WriteOperation write_operation;
+    DrainOperation drain_operation;
+    bool failed{};
+};
+
+AGRPC_NAMESPACE_END
+#endif
+
+#endif  // AGRPC_AGRPC_WRITEQUEUE_HPP
@@ -0,0 +1,290 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/v1/test.grpc.pb.h"
+#include "utils/asioUtils.hpp"
+#include "utils/countingMemoryResource.hpp"
+#include "utils/grpcClientServerTest.hpp"
+#include "utils/grpcContextTest.hpp"
+#include "utils/rpc.hpp"
+#include "utils/time.hpp"
+
+#include <agrpc/bindAllocator.hpp>
+#include <agrpc/detail/oneShotAllocator.hpp>
+#include <agrpc/handlerMemory.hpp>
+#include <agrpc/repeatedlyRequest.hpp>
+#include <agrpc/rpc.hpp>
+#include <agrpc/unaryCall.hpp>
+#include <agrpc/wait.hpp>
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
+{
+TEST_CASE_FIXTURE(test::GrpcContextTest, "asio::post does not allocate from the upstream resource after warm-up")
+{
+    static constexpr int POST_COUNT = 10;
+    int invoked{};
+    const auto post_from_within_grpc_context = [&]
+    {
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       for (int i{}; i < POST_COUNT; ++i)
+                       {
+                           asio::post(grpc_context,
+                                      [&]
+                                      {
+                                          ++invoked;
+                                      });
+                       }
+                   });
+    };
+    post_from_within_grpc_context();
+    grpc_context.run();
+    const auto allocations_after_warm_up = upstream_resource.allocations;
+    CHECK_LT(0, allocations_after_warm_up);
+    grpc_context.reset();
+    post_from_within_grpc_context();
+    grpc_context.run();
+    CHECK_EQ(2 * POST_COUNT, invoked);
+    CHECK_EQ(allocations_after_warm_up, upstream_resource.allocations);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "agrpc::wait with bind_allocator over a OneShotAllocator does not allocate")
+{
+    static constexpr std::size_t BUFFER_SIZE = 256;
+    alignas(std::max_align_t) std::array<std::byte, BUFFER_SIZE> wait_buffer{};
+    bool ok{false};
+    grpc::Alarm alarm;
+    agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                agrpc::bind_allocator(agrpc::detail::OneShotAllocator<std::byte, BUFFER_SIZE>{wait_buffer.data()},
+                                      asio::bind_executor(grpc_context,
+                                                          [&](bool wait_ok)
+                                                          {
+                                                              ok = wait_ok;
+                                                          })));
+    grpc_context.run();
+    CHECK(ok);
+    CHECK_EQ(0, upstream_resource.allocations);
+    CHECK(std::any_of(wait_buffer.begin(), wait_buffer.end(),
+                      [](auto&& value)
+                      {
+                          return value != std::byte{};
+                      }));
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "HandlerMemory is reused by sequential agrpc::wait")
+{
+    static constexpr int WAIT_COUNT = 3;
+    int ok_count{};
+    const auto on_wait = [&](bool ok)
+    {
+        ok_count += static_cast<int>(ok);
+    };
+    using Handler = decltype(asio::bind_executor(grpc_context, on_wait));
+    agrpc::HandlerMemory<agrpc::HANDLER_MEMORY_SIZE_V<Handler>> memory;
+    grpc::Alarm alarm;
+    for (int i{}; i < WAIT_COUNT; ++i)
+    {
+        agrpc::wait(alarm, test::five_seconds_from_now(), memory.bind(asio::bind_executor(grpc_context, on_wait)));
+        CHECK(memory.in_use());
+        alarm.Cancel();
+        grpc_context.run();
+        grpc_context.reset();
+        CHECK_FALSE(memory.in_use());
+    }
+    CHECK_EQ(0, ok_count);
+    CHECK_EQ(0, memory.overflow_count());
+    CHECK_EQ(0, upstream_resource.allocations);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "HandlerMemory falls back to std::allocator when it is too small")
+{
+    bool ok{};
+    const auto on_wait = [&](bool wait_ok)
+    {
+        ok = wait_ok;
+    };
+    using Handler = decltype(asio::bind_executor(grpc_context, on_wait));
+    agrpc::HandlerMemory<agrpc::HANDLER_MEMORY_SIZE_V<Handler> - 1> memory;
+    grpc::Alarm alarm;
+    agrpc::wait(alarm, test::ten_milliseconds_from_now(), memory.bind(asio::bind_executor(grpc_context, on_wait)));
+    CHECK_FALSE(memory.in_use());
+    grpc_context.run();
+    CHECK(ok);
+    CHECK_EQ(1, memory.overflow_count());
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "HandlerMemory falls back to std::allocator when it is in use")
+{
+    int ok_count{};
+    const auto on_wait = [&](bool ok)
+    {
+        ok_count += static_cast<int>(ok);
+    };
+    using Handler = decltype(asio::bind_executor(grpc_context, on_wait));
+    agrpc::HandlerMemory<agrpc::HANDLER_MEMORY_SIZE_V<Handler>> memory;
+    grpc::Alarm alarm1;
+    grpc::Alarm alarm2;
+    agrpc::wait(alarm1, test::ten_milliseconds_from_now(), memory.bind(asio::bind_executor(grpc_context, on_wait)));
+    agrpc::wait(alarm2, test::ten_milliseconds_from_now(), memory.bind(asio::bind_executor(grpc_context, on_wait)));
+    grpc_context.run();
+    CHECK_EQ(2, ok_count);
+    CHECK_EQ(1, memory.overflow_count());
+    CHECK_FALSE(memory.in_use());
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest,
+                  "agrpc::read and agrpc::write with bind_allocator do not allocate from the upstream resource")
+{
+    static constexpr int ROUND_COUNT = 3;
+    test::CountingMemoryResource bound_resource{&resource};
+    const auto bound = [&](auto&& yield)
+    {
+        return agrpc::bind_allocator(bound_resource.get_allocator(), yield);
+    };
+    std::size_t allocations_after_warm_up{};
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    grpc::ServerAsyncReaderWriter<test::msg::Response, test::msg::Request> reader_writer{
+                        &server_context};
+                    CHECK(agrpc::request(&test::v1::Test::AsyncService::RequestBidirectionalStreaming, service,
+                                         server_context, reader_writer, yield));
+                    test::msg::Request request;
+                    test::msg::Response response;
+                    for (int i{}; i < ROUND_COUNT; ++i)
+                    {
+                        CHECK(agrpc::read(reader_writer, request, bound(yield)));
+                        CHECK_EQ(i, request.integer());
+                        response.set_integer(i);
+                        CHECK(agrpc::write(reader_writer, response, bound(yield)));
+                    }
+                    CHECK(agrpc::finish(reader_writer, grpc::Status::OK, yield));
+                });
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    std::unique_ptr<grpc::ClientAsyncReaderWriter<test::msg::Request, test::msg::Response>>
+                        reader_writer;
+                    CHECK(agrpc::request(&test::v1::Test::Stub::AsyncBidirectionalStreaming, *stub, client_context,
+                                         reader_writer, yield));
+                    test::msg::Request request;
+                    test::msg::Response response;
+                    for (int i{}; i < ROUND_COUNT; ++i)
+                    {
+                        request.set_integer(i);
+                        CHECK(agrpc::write(*reader_writer, request, bound(yield)));
+                        CHECK(agrpc::read(*reader_writer, response, bound(yield)));
+                        CHECK_EQ(i, response.integer());
+                        if (i == 0)
+                        {
+                            allocations_after_warm_up = upstream_resource.allocations;
+                        }
+                    }
+                    CHECK(agrpc::writes_done(*reader_writer, yield));
+                    grpc::Status status;
+                    CHECK(agrpc::finish(*reader_writer, status, yield));
+                    CHECK(status.ok());
+                });
+    grpc_context.run();
+    CHECK_EQ(allocations_after_warm_up, upstream_resource.allocations);
+    CHECK_EQ(4 * ROUND_COUNT, bound_resource.allocations);
+    CHECK(allocator_has_been_used());
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "unary_call makes a single allocation per call")
+{
+    static constexpr int CALL_COUNT = 5;
+    test::CountingMemoryResource bound_resource{&resource};
+    agrpc::repeatedly_request(&test::v1::Test::AsyncService::RequestUnary, service,
+                              asio::bind_executor(get_executor(),
+                                                  [&](auto&& rpc_context)
+                                                  {
+                                                      test::msg::Response response;
+                                                      response.set_integer(21);
+                                                      auto& responder = rpc_context.responder();
+                                                      agrpc::finish(responder, response, grpc::Status::OK,
+                                                                    asio::bind_executor(get_executor(),
+                                                                                        [c = std::move(rpc_context)](
+                                                                                            bool) {}));
+                                                  }));
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    test::msg::Request request;
+                    request.set_integer(42);
+                    for (int i{}; i < CALL_COUNT; ++i)
+                    {
+                        grpc::ClientContext context;
+                        context.set_deadline(test::five_seconds_from_now());
+                        test::msg::Response response;
+                        CHECK(agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub, context, request,
+                                                response, agrpc::bind_allocator(bound_resource.get_allocator(), yield))
+                                  .ok());
+                        CHECK_EQ(21, response.integer());
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    // The reader and the status are stored inside of the operation
+    CHECK_EQ(CALL_COUNT, bound_resource.allocations);
+    CHECK_EQ(CALL_COUNT, bound_resource.deallocations);
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "repeatedly_request does not allocate in steady state")
+{
+    static constexpr int WARM_UP_COUNT = 3;
+    static constexpr int REQUEST_COUNT = 10;
+    test::CountingMemoryResource handler_resource;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, agrpc::RepeatedlyRequestOptions{WARM_UP_COUNT + 1},
+        agrpc::bind_allocator(handler_resource.get_allocator(),
+                              asio::bind_executor(get_executor(),
+                                                  [&](auto&& rpc_context)
+                                                  {
+                                                      test::msg::Response response;
+                                                      response.set_integer(21);
+                                                      auto& responder = rpc_context.responder();
+                                                      agrpc::finish(responder, response, grpc::Status::OK,
+                                                                    asio::bind_executor(get_executor(),
+                                                                                        [c = std::move(rpc_context)](
+                                                                                            bool) {}));
+                                                  })));
+    std::size_t upstream_allocations_after_warm_up{};
+    std::size_t handler_allocations_after_warm_up{};
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    for (int i{}; i < REQUEST_COUNT; ++i)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                        if (i == WARM_UP_COUNT - 1)
+                        {
+                            upstream_allocations_after_warm_up = upstream_resource.allocations;
+                            handler_allocations_after_warm_up = handler_resource.allocations;
+                        }
+                    }
+                    CHECK_EQ(upstream_allocations_after_warm_up, upstream_resource.allocations);
+                    CHECK_EQ(handler_allocations_after_warm_up, handler_resource.allocations);
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_LT(0, handler_allocations_after_warm_up);
+}
+}
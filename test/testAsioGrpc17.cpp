@@ -14,17 +14,22 @@
 
 #include "test/v1/test.grpc.pb.h"
 #include "utils/asioUtils.hpp"
+#include "utils/countingMemoryResource.hpp"
 #include "utils/grpcClientServerTest.hpp"
 #include "utils/grpcContextTest.hpp"
 #include "utils/rpc.hpp"
+#include "utils/time.hpp"
 
 #include <agrpc/grpcInitiate.hpp>
+#include <agrpc/repeatedlyRequest.hpp>
 #include <agrpc/rpc.hpp>
+#include <agrpc/unaryCall.hpp>
 #include <agrpc/wait.hpp>
 #include <doctest/doctest.h>
 
 #include <cstddef>
 #include <boost/optional.hpp>
+#include <memory>
 #include <thread>
 
 DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
@@ -356,6 +361,100 @@ TEST_CASE_FIXTURE(test::GrpcClientServerTest, "yield_context unary")
     grpc_context.run();
 }
 
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "yield_context unary_call")
+{
+    bool use_finish_with_error{false};
+    SUBCASE("server finish_with_error") { use_finish_with_error = true; }
+    SUBCASE("server finish with OK") {}
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    test::msg::Request request;
+                    grpc::ServerAsyncResponseWriter<test::msg::Response> writer{&server_context};
+                    CHECK(agrpc::request(&test::v1::Test::AsyncService::RequestUnary, service, server_context, request,
+                                         writer, yield));
+                    CHECK_EQ(42, request.integer());
+                    test::msg::Response response;
+                    response.set_integer(21);
+                    if (use_finish_with_error)
+                    {
+                        CHECK(agrpc::finish_with_error(writer, grpc::Status::CANCELLED, yield));
+                    }
+                    else
+                    {
+                        CHECK(agrpc::finish(writer, response, grpc::Status::OK, yield));
+                    }
+                });
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    test::msg::Request request;
+                    request.set_integer(42);
+                    test::msg::Response response;
+                    const auto status = agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub,
+                                                          client_context, request, response, yield);
+                    if (use_finish_with_error)
+                    {
+                        CHECK_EQ(grpc::StatusCode::CANCELLED, status.error_code());
+                    }
+                    else
+                    {
+                        CHECK(status.ok());
+                        CHECK_EQ(21, response.integer());
+                    }
+                });
+    grpc_context.run();
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "unary_call does not allocate from the GrpcContext after warm-up")
+{
+    static constexpr int CALL_COUNT = 10;
+    test::CountingMemoryResource upstream;
+    agrpc::GrpcContext client_grpc_context{std::make_unique<grpc::CompletionQueue>(), &upstream};
+    agrpc::repeatedly_request(&test::v1::Test::AsyncService::RequestUnary, service,
+                              asio::bind_executor(get_executor(),
+                                                  [&](auto&& rpc_context)
+                                                  {
+                                                      test::msg::Response response;
+                                                      response.set_integer(21);
+                                                      auto& responder = rpc_context.responder();
+                                                      agrpc::finish(responder, response, grpc::Status::OK,
+                                                                    asio::bind_executor(get_executor(),
+                                                                                        [c = std::move(rpc_context)](
+                                                                                            bool) {}));
+                                                  }));
+    std::thread server_thread{[&]
+                              {
+                                  grpc_context.run();
+                              }};
+    std::size_t allocations_after_warm_up{};
+    asio::spawn(client_grpc_context,
+                [&](asio::yield_context yield)
+                {
+                    test::msg::Request request;
+                    request.set_integer(42);
+                    for (int i{}; i < CALL_COUNT; ++i)
+                    {
+                        grpc::ClientContext context;
+                        context.set_deadline(test::five_seconds_from_now());
+                        test::msg::Response response;
+                        CHECK(agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub, context, request,
+                                                response, yield)
+                                  .ok());
+                        CHECK_EQ(21, response.integer());
+                        if (i == 0)
+                        {
+                            allocations_after_warm_up = upstream.allocations;
+                        }
+                    }
+                });
+    client_grpc_context.run();
+    grpc_context.stop();
+    server_thread.join();
+    CHECK_LT(0, allocations_after_warm_up);
+    CHECK_EQ(allocations_after_warm_up, upstream.allocations);
+}
+
 TEST_CASE_FIXTURE(test::GrpcClientServerTest, "yield_context bidirectional streaming")
 {
     bool use_write_and_finish{false};
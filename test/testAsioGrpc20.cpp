@@ -15,13 +15,21 @@
 #include "test/v1/test.grpc.pb.h"
 #include "utils/asioUtils.hpp"
 #include "utils/grpcClientServerTest.hpp"
+#include "utils/grpcContextTest.hpp"
 #include "utils/time.hpp"
 
 #include <agrpc/rpc.hpp>
+#include <agrpc/streamReader.hpp>
+#include <agrpc/unaryCall.hpp>
 #include <agrpc/wait.hpp>
+#include <agrpc/writeQueue.hpp>
 #include <doctest/doctest.h>
 
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
 
 #ifdef AGRPC_ASIO_HAS_CO_AWAIT
 DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
@@ -157,6 +165,100 @@ TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable unary")
     grpc_context.run();
 }
 
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable unary_call")
+{
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       grpc::ServerAsyncResponseWriter<test::msg::Response> writer{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestUnary, service,
+                                                     server_context, request, writer));
+                       CHECK_EQ(42, request.integer());
+                       test::msg::Response response;
+                       response.set_integer(21);
+                       CHECK(co_await agrpc::finish(writer, response, grpc::Status::OK));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       request.set_integer(42);
+                       test::msg::Response response;
+                       const auto status = co_await agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub,
+                                                                      client_context, request, response);
+                       CHECK(status.ok());
+                       CHECK_EQ(21, response.integer());
+                   });
+    grpc_context.run();
+}
+
+#ifdef AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable unary_call does not allocate from the GrpcContext")
+{
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       grpc::ServerAsyncResponseWriter<test::msg::Response> writer{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestUnary, service,
+                                                     server_context, request, writer));
+                       test::msg::Response response;
+                       response.set_integer(request.integer());
+                       CHECK(co_await agrpc::finish(writer, response, grpc::Status::OK));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       request.set_integer(42);
+                       test::msg::Response response;
+                       const auto status = co_await agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub,
+                                                                      client_context, request, response);
+                       CHECK(status.ok());
+                       CHECK_EQ(42, response.integer());
+                   });
+    grpc_context.run();
+    CHECK_EQ(0, upstream_resource.allocations);
+}
+#endif
+
+#ifdef AGRPC_ASIO_HAS_CANCELLATION_SLOT
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "asio::execution connect and start unary_call")
+{
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       grpc::ServerAsyncResponseWriter<test::msg::Response> writer{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestUnary, service,
+                                                     server_context, request, writer));
+                       test::msg::Response response;
+                       response.set_integer(21);
+                       CHECK(co_await agrpc::finish(writer, response, grpc::Status::OK));
+                   });
+    test::msg::Request request;
+    request.set_integer(42);
+    test::msg::Response response;
+    grpc::Status status{grpc::StatusCode::UNKNOWN, ""};
+    test::FunctionAsReceiver receiver{[&](grpc::Status call_status)
+                                      {
+                                          status = std::move(call_status);
+                                      }};
+    auto operation_state = asio::execution::connect(
+        agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub, client_context, request, response,
+                          use_sender()),
+        std::move(receiver));
+    asio::execution::start(operation_state);
+    grpc_context.run();
+    CHECK(status.ok());
+    CHECK_EQ(21, response.integer());
+#ifdef AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+    CHECK_EQ(0, upstream_resource.allocations);
+#endif
+}
+#endif
+
 TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable bidirectional streaming")
 {
     bool use_write_and_finish{false};
@@ -207,6 +309,351 @@ TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable bidirectional streaming
     grpc_context.run();
 }
 
+#ifdef AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+TEST_CASE_FIXTURE(test::GrpcContextTest, "awaitable rpc functions do not allocate from the GrpcContext")
+{
+    static constexpr int COROUTINE_COUNT = 32;
+    int completed{};
+    for (int i{}; i < COROUTINE_COUNT; ++i)
+    {
+        test::co_spawn(grpc_context,
+                       [&]() -> asio::awaitable<void>
+                       {
+                           grpc::Alarm alarm;
+                           CHECK(co_await agrpc::wait(alarm, test::ten_milliseconds_from_now()));
+                           CHECK(co_await agrpc::wait(alarm, test::ten_milliseconds_from_now(), asio::use_awaitable));
+                           ++completed;
+                       });
+    }
+    grpc_context.run();
+    CHECK_EQ(COROUTINE_COUNT, completed);
+    CHECK_EQ(0, upstream_resource.allocations);
+}
+#endif
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "awaitable rpc function that is pending when the GrpcContext is destructed")
+{
+    auto alarm = std::make_unique<grpc::Alarm>();
+    bool completed{};
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       co_await agrpc::wait(*alarm, test::five_seconds_from_now());
+                       completed = true;
+                   });
+    grpc_context.poll();
+    alarm->Cancel();
+    CHECK_FALSE(completed);
+}
+
+#ifdef AGRPC_ASIO_HAS_AWAITABLE_FRAME_INITIATION
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable bidirectional streaming does not allocate from the GrpcContext")
+{
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       grpc::ServerAsyncReaderWriter<test::msg::Response, test::msg::Request> reader_writer{
+                           &server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestBidirectionalStreaming,
+                                                     service, server_context, reader_writer));
+                       test::msg::Request request;
+                       CHECK(co_await agrpc::read(reader_writer, request));
+                       test::msg::Response response;
+                       response.set_integer(request.integer());
+                       CHECK(co_await agrpc::write(reader_writer, response));
+                       CHECK(co_await agrpc::finish(reader_writer, grpc::Status::OK));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       std::unique_ptr<grpc::ClientAsyncReaderWriter<test::msg::Request, test::msg::Response>>
+                           reader_writer;
+                       CHECK(co_await agrpc::request(&test::v1::Test::Stub::AsyncBidirectionalStreaming, *stub,
+                                                     client_context, reader_writer));
+                       test::msg::Request request;
+                       request.set_integer(42);
+                       CHECK(co_await agrpc::write(*reader_writer, request));
+                       test::msg::Response response;
+                       CHECK(co_await agrpc::read(*reader_writer, response));
+                       CHECK(co_await agrpc::writes_done(*reader_writer));
+                       grpc::Status status;
+                       CHECK(co_await agrpc::finish(*reader_writer, status));
+                       CHECK(status.ok());
+                       CHECK_EQ(42, response.integer());
+                   });
+    grpc_context.run();
+    CHECK_EQ(0, upstream_resource.allocations);
+}
+#endif
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable StreamReader reads ahead while a message is processed")
+{
+    static constexpr int MESSAGE_COUNT = 5;
+    static constexpr std::size_t CAPACITY = 3;
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       grpc::ServerAsyncReader<test::msg::Response, test::msg::Request> responder{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestClientStreaming, service,
+                                                     server_context, responder));
+                       agrpc::StreamReader<decltype(responder), CAPACITY> reader{responder};
+                       CHECK(co_await reader.next());
+                       CHECK_EQ(0, reader.message().integer());
+                       CHECK(reader.is_reading());
+                       grpc::Alarm alarm;
+                       for (int i{}; i < 500 && reader.ready_count() < CAPACITY - 1; ++i)
+                       {
+                           co_await agrpc::wait(alarm, test::ten_milliseconds_from_now());
+                       }
+                       CHECK_EQ(CAPACITY - 1, reader.ready_count());
+                       CHECK_FALSE(reader.is_reading());
+                       int expected{1};
+                       while (co_await reader.next())
+                       {
+                           CHECK_EQ(expected, reader.message().integer());
+                           ++expected;
+                       }
+                       CHECK_EQ(MESSAGE_COUNT, expected);
+                       CHECK_FALSE(reader.is_reading());
+                       test::msg::Response response;
+                       response.set_integer(expected);
+                       CHECK(co_await agrpc::finish(responder, response, grpc::Status::OK));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Response response;
+                       std::unique_ptr<grpc::ClientAsyncWriter<test::msg::Request>> writer;
+                       CHECK(co_await agrpc::request(&test::v1::Test::Stub::AsyncClientStreaming, *stub, client_context,
+                                                     writer, response));
+                       test::msg::Request request;
+                       for (int i{}; i < MESSAGE_COUNT; ++i)
+                       {
+                           request.set_integer(i);
+                           CHECK(co_await agrpc::write(*writer, request));
+                       }
+                       CHECK(co_await agrpc::writes_done(*writer));
+                       grpc::Status status;
+                       CHECK(co_await agrpc::finish(*writer, status));
+                       CHECK(status.ok());
+                       CHECK_EQ(MESSAGE_COUNT, response.integer());
+                   });
+    grpc_context.run();
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable StreamReader can be destroyed after draining an early exit")
+{
+    static constexpr int MESSAGE_COUNT = 5;
+    bool read_remaining{false};
+    SUBCASE("destroy right after drain") {}
+    SUBCASE("resume reading after drain") { read_remaining = true; }
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       grpc::ServerAsyncReader<test::msg::Response, test::msg::Request> responder{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestClientStreaming, service,
+                                                     server_context, responder));
+                       auto reader = std::make_unique<agrpc::StreamReader<decltype(responder), 3>>(responder);
+                       CHECK(co_await reader->next());
+                       CHECK_EQ(0, reader->message().integer());
+                       CHECK(reader->is_reading());
+                       CHECK(co_await reader->drain());
+                       CHECK_FALSE(reader->is_reading());
+                       CHECK_EQ(0, reader->message().integer());
+                       if (read_remaining)
+                       {
+                           int expected{1};
+                           while (co_await reader->next())
+                           {
+                               CHECK_EQ(expected, reader->message().integer());
+                               ++expected;
+                           }
+                           CHECK_EQ(MESSAGE_COUNT, expected);
+                           CHECK_FALSE(co_await reader->drain());
+                       }
+                       reader.reset();
+                       test::msg::Response response;
+                       response.set_integer(42);
+                       CHECK(co_await agrpc::finish(responder, response, grpc::Status::OK));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Response response;
+                       std::unique_ptr<grpc::ClientAsyncWriter<test::msg::Request>> writer;
+                       CHECK(co_await agrpc::request(&test::v1::Test::Stub::AsyncClientStreaming, *stub, client_context,
+                                                     writer, response));
+                       test::msg::Request request;
+                       for (int i{}; i < MESSAGE_COUNT; ++i)
+                       {
+                           request.set_integer(i);
+                           co_await agrpc::write(*writer, request);
+                       }
+                       co_await agrpc::writes_done(*writer);
+                       grpc::Status status;
+                       CHECK(co_await agrpc::finish(*writer, status));
+                       CHECK(status.ok());
+                       CHECK_EQ(42, response.integer());
+                   });
+    grpc_context.run();
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable StreamReader client-side server streaming")
+{
+    static constexpr int MESSAGE_COUNT = 3;
+    std::size_t capacity{};
+    SUBCASE("capacity one") { capacity = 1; }
+    SUBCASE("capacity two") { capacity = 2; }
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       grpc::ServerAsyncWriter<test::msg::Response> writer{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestServerStreaming, service,
+                                                     server_context, request, writer));
+                       test::msg::Response response;
+                       for (int i{}; i < MESSAGE_COUNT; ++i)
+                       {
+                           response.set_integer(i);
+                           CHECK(co_await agrpc::write(writer, response));
+                       }
+                       CHECK(co_await agrpc::finish(writer, grpc::Status::OK));
+                   });
+    const auto read_all = [&]<std::size_t Capacity>(
+                              grpc::ClientAsyncReader<test::msg::Response>& responder,
+                              std::integral_constant<std::size_t, Capacity>) -> asio::awaitable<int>
+    {
+        agrpc::StreamReader<grpc::ClientAsyncReader<test::msg::Response>, Capacity> reader{responder};
+        int count{};
+        while (co_await reader.next())
+        {
+            CHECK_EQ(count, reader.message().integer());
+            ++count;
+        }
+        CHECK_FALSE(reader.is_reading());
+        co_return count;
+    };
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       std::unique_ptr<grpc::ClientAsyncReader<test::msg::Response>> responder;
+                       CHECK(co_await agrpc::request(&test::v1::Test::Stub::AsyncServerStreaming, *stub, client_context,
+                                                     request, responder));
+                       int count{};
+                       if (1 == capacity)
+                       {
+                           count = co_await read_all(*responder, std::integral_constant<std::size_t, 1>{});
+                       }
+                       else
+                       {
+                           count = co_await read_all(*responder, std::integral_constant<std::size_t, 2>{});
+                       }
+                       CHECK_EQ(MESSAGE_COUNT, count);
+                       grpc::Status status;
+                       CHECK(co_await agrpc::finish(*responder, status));
+                       CHECK(status.ok());
+                   });
+    grpc_context.run();
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable WriteQueue writes messages from a thread_pool in order")
+{
+    static constexpr int PRODUCER_COUNT = 3;
+    static constexpr int MESSAGE_COUNT = 20;
+    asio::thread_pool thread_pool{2};
+    grpc::ServerAsyncWriter<test::msg::Response> writer{&server_context};
+    std::optional<agrpc::WriteQueue<decltype(writer)>> write_queue;
+    int remaining_producers{PRODUCER_COUNT};
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestServerStreaming, service,
+                                                     server_context, request, writer));
+                       write_queue.emplace(grpc_context, writer);
+                       for (int producer{}; producer < PRODUCER_COUNT; ++producer)
+                       {
+                           test::co_spawn(grpc_context,
+                                          [&, producer]() -> asio::awaitable<void>
+                                          {
+                                              test::msg::Response response;
+                                              for (int i{}; i < MESSAGE_COUNT; ++i)
+                                              {
+                                                  co_await asio::post(
+                                                      asio::bind_executor(thread_pool, asio::use_awaitable));
+                                                  response.set_integer(producer * MESSAGE_COUNT + i);
+                                                  CHECK(co_await write_queue->write(response));
+                                              }
+                                              if (--remaining_producers == 0)
+                                              {
+                                                  CHECK(co_await write_queue->flush());
+                                                  CHECK(co_await agrpc::finish(writer, grpc::Status::OK));
+                                              }
+                                          });
+                       }
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       std::unique_ptr<grpc::ClientAsyncReader<test::msg::Response>> responder;
+                       CHECK(co_await agrpc::request(&test::v1::Test::Stub::AsyncServerStreaming, *stub, client_context,
+                                                     request, responder));
+                       test::msg::Response response;
+                       std::array<int, PRODUCER_COUNT> next_message{};
+                       int count{};
+                       while (co_await agrpc::read(*responder, response))
+                       {
+                           const auto producer = response.integer() / MESSAGE_COUNT;
+                           CHECK_EQ(next_message[producer], response.integer() % MESSAGE_COUNT);
+                           ++next_message[producer];
+                           ++count;
+                       }
+                       CHECK_EQ(PRODUCER_COUNT * MESSAGE_COUNT, count);
+                       grpc::Status status;
+                       CHECK(co_await agrpc::finish(*responder, status));
+                       CHECK(status.ok());
+                   });
+    grpc_context.run();
+    thread_pool.join();
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable WriteQueue completes with false after a write failed")
+{
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       grpc::ServerAsyncWriter<test::msg::Response> responder{&server_context};
+                       CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestServerStreaming, service,
+                                                     server_context, request, responder));
+                       agrpc::WriteQueue<decltype(responder)> write_queue{grpc_context, responder};
+                       server_context.TryCancel();
+                       test::msg::Response response;
+                       bool ok{true};
+                       for (int i{}; i < 10 && ok; ++i)
+                       {
+                           ok = co_await write_queue.write(response);
+                       }
+                       CHECK_FALSE(ok);
+                       CHECK_FALSE(co_await write_queue.flush());
+                       CHECK_FALSE(co_await write_queue.write(response));
+                   });
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       test::msg::Request request;
+                       std::unique_ptr<grpc::ClientAsyncReader<test::msg::Response>> responder;
+                       co_await agrpc::request(&test::v1::Test::Stub::AsyncServerStreaming, *stub, client_context,
+                                               request, responder);
+                       grpc::Status status;
+                       co_await agrpc::finish(*responder, status);
+                       CHECK_FALSE(status.ok());
+                   });
+    grpc_context.run();
+}
+
 #ifdef AGRPC_ASIO_HAS_CANCELLATION_SLOT
 template <class Function>
 asio::awaitable<void> run_with_deadline(grpc::Alarm& alarm, grpc::ClientContext& client_context,
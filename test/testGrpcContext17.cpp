@@ -13,13 +13,28 @@
 // limitations under the License.
 
 #include "utils/asioUtils.hpp"
+#include "utils/countingMemoryResource.hpp"
 #include "utils/grpcContextTest.hpp"
 #include "utils/time.hpp"
 
+#include <agrpc/detail/remoteMemoryPool.hpp>
 #include <agrpc/grpcContext.hpp>
+#include <agrpc/latencyHistogram.hpp>
 #include <agrpc/wait.hpp>
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
 {
 TEST_CASE("GrpcExecutor fulfills Executor TS traits")
@@ -454,4 +469,644 @@ TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.poll() with grpc::Alarm")
     io_context.run();
     CHECK(invoked);
 }
-}
\ No newline at end of file
+
+struct BatchingRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr std::size_t MAX_COMPLETION_QUEUE_EVENTS = 64;
+};
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.run() with custom traits completes all operations")
+{
+    int count{};
+    std::array<grpc::Alarm, 10> alarms;
+    for (auto& alarm : alarms)
+    {
+        agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                    asio::bind_executor(grpc_context,
+                                        [&](bool ok)
+                                        {
+                                            CHECK(ok);
+                                            ++count;
+                                            asio::post(grpc_context,
+                                                       [&]
+                                                       {
+                                                           ++count;
+                                                       });
+                                        }));
+    }
+    grpc_context.run<BatchingRunTraits>();
+    CHECK_EQ(20, count);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.poll() with custom traits completes ready operations")
+{
+    int count{};
+    std::array<grpc::Alarm, 10> alarms;
+    for (auto& alarm : alarms)
+    {
+        agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                    asio::bind_executor(grpc_context,
+                                        [&](bool)
+                                        {
+                                            ++count;
+                                        }));
+    }
+    while (count < 10)
+    {
+        grpc_context.poll<BatchingRunTraits>();
+    }
+    CHECK(grpc_context.is_stopped());
+    CHECK_EQ(10, count);
+}
+
+struct LocalOperationBudgetTraits : agrpc::DefaultRunTraits
+{
+    static constexpr std::size_t MAX_LOCAL_OPERATIONS = 2;
+
+    static inline std::size_t rounds{};
+    static inline std::size_t max_local_operations{};
+    static inline std::size_t total_local_operations{};
+
+    static void on_round_completed(agrpc::GrpcContext&, const agrpc::RunRoundStatistics& statistics) noexcept
+    {
+        ++rounds;
+        max_local_operations = std::max(max_local_operations, statistics.local_operations);
+        total_local_operations += statistics.local_operations;
+    }
+};
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.run() with custom traits limits local operations per round")
+{
+    int count{};
+    for (int i{}; i < 7; ++i)
+    {
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       ++count;
+                   });
+    }
+    grpc_context.run<LocalOperationBudgetTraits>();
+    CHECK_EQ(7, count);
+    CHECK_EQ(2, LocalOperationBudgetTraits::max_local_operations);
+    CHECK_EQ(7, LocalOperationBudgetTraits::total_local_operations);
+    CHECK_LE(4, LocalOperationBudgetTraits::rounds);
+}
+
+struct BusyPollRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr std::chrono::microseconds BUSY_POLL_DURATION{std::chrono::milliseconds(5)};
+};
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.run() with busy-polling completes local, remote and alarm work")
+{
+    int count{};
+    grpc::Alarm alarm;
+    agrpc::wait(alarm, test::hundred_milliseconds_from_now(),
+                asio::bind_executor(grpc_context,
+                                    [&](bool ok)
+                                    {
+                                        CHECK(ok);
+                                        ++count;
+                                    }));
+    asio::post(grpc_context,
+               [&]
+               {
+                   ++count;
+               });
+    std::thread thread{[&]
+                       {
+                           asio::post(grpc_context,
+                                      [&]
+                                      {
+                                          ++count;
+                                      });
+                       }};
+    grpc_context.run<BusyPollRunTraits>();
+    thread.join();
+    CHECK_EQ(3, count);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.stop() interrupts busy-polling run()")
+{
+    grpc_context.work_started();
+    std::thread thread{[&]
+                       {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                           grpc_context.stop();
+                       }};
+    grpc_context.run<BusyPollRunTraits>();
+    thread.join();
+    CHECK(grpc_context.is_stopped());
+    grpc_context.work_finished();
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "asio::post from another thread wakes up a blocked GrpcContext.run()")
+{
+    int count{};
+    grpc_context.work_started();
+    std::thread thread{[&]
+                       {
+                           for (int i{}; i < 3; ++i)
+                           {
+                               std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                               asio::post(grpc_context,
+                                          [&]
+                                          {
+                                              ++count;
+                                              if (3 == count)
+                                              {
+                                                  grpc_context.work_finished();
+                                              }
+                                          });
+                           }
+                       }};
+    grpc_context.run();
+    thread.join();
+    CHECK_EQ(3, count);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.poll() completes operations posted from another thread")
+{
+    int count{};
+    grpc_context.work_started();
+    grpc_context.poll();
+    std::thread{[&]
+                {
+                    asio::post(grpc_context,
+                               [&]
+                               {
+                                   ++count;
+                               });
+                }}
+        .join();
+    grpc_context.work_finished();
+    while (0 == count)
+    {
+        grpc_context.poll();
+    }
+    CHECK_EQ(1, count);
+}
+
+struct MetricsRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr bool ENABLE_METRICS = true;
+};
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.metrics() with metrics enabled")
+{
+    int count{};
+    grpc::Alarm alarm;
+    agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                asio::bind_executor(grpc_context,
+                                    [&](bool)
+                                    {
+                                        ++count;
+                                    }));
+    asio::post(grpc_context,
+               [&]
+               {
+                   ++count;
+                   asio::post(grpc_context,
+                              [&]
+                              {
+                                  ++count;
+                              });
+                   asio::post(grpc_context,
+                              [&]
+                              {
+                                  ++count;
+                              });
+               });
+    grpc_context.work_started();
+    std::thread thread{[&]
+                       {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                           asio::post(grpc_context,
+                                      [&]
+                                      {
+                                          ++count;
+                                          grpc_context.work_finished();
+                                      });
+                       }};
+    grpc_context.run<MetricsRunTraits>();
+    thread.join();
+    CHECK_EQ(5, count);
+    const auto metrics = grpc_context.metrics();
+    CHECK_EQ(1, metrics.completion_queue_events);
+    CHECK_EQ(4, metrics.local_operations);
+    CHECK_EQ(2, metrics.remote_operations);
+    CHECK_LE(1, metrics.work_alarm_wakeups);
+    CHECK_LE(2, metrics.max_local_queue_depth);
+    CHECK_LT(std::chrono::nanoseconds::zero(), metrics.blocked_duration);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.metrics() are not collected by default")
+{
+    bool invoked{};
+    asio::post(grpc_context,
+               [&]
+               {
+                   invoked = true;
+               });
+    grpc_context.run();
+    CHECK(invoked);
+    const auto metrics = grpc_context.metrics();
+    CHECK_EQ(0, metrics.local_operations);
+    CHECK_EQ(0, metrics.remote_operations);
+    CHECK_EQ(0, metrics.work_alarm_wakeups);
+    CHECK_EQ(0, metrics.max_local_queue_depth);
+    CHECK_EQ(std::chrono::nanoseconds::zero(), metrics.blocked_duration);
+}
+
+TEST_CASE("LatencyHistogram reports percentiles within its precision")
+{
+    auto histogram = std::make_unique<agrpc::LatencyHistogram>();
+    CHECK_EQ(0, histogram->count());
+    CHECK_EQ(std::chrono::nanoseconds::zero(), histogram->percentile(50.0));
+    for (int i{1}; i <= 100; ++i)
+    {
+        histogram->record(std::chrono::microseconds(i));
+    }
+    CHECK_EQ(100, histogram->count());
+    const auto p50 = histogram->percentile(50.0);
+    CHECK_LE(std::chrono::microseconds(50), p50);
+    CHECK_GE(std::chrono::nanoseconds(51500), p50);
+    const auto p100 = histogram->percentile(100.0);
+    CHECK_LE(std::chrono::microseconds(100), p100);
+    CHECK_GE(std::chrono::nanoseconds(103000), p100);
+    histogram->record(std::chrono::nanoseconds(7));
+    CHECK_EQ(std::chrono::nanoseconds(7), histogram->percentile(0.0));
+    histogram->record(std::chrono::hours(1));
+    CHECK_EQ(agrpc::LatencyHistogram::MAX_DURATION, histogram->percentile(100.0));
+    histogram->reset();
+    CHECK_EQ(0, histogram->count());
+}
+
+agrpc::OperationLatencyHistograms operation_latency_histograms;
+
+struct OperationTimingRunTraits : agrpc::DefaultRunTraits
+{
+    static constexpr bool ENABLE_OPERATION_TIMING = true;
+
+    static void on_operation_completed(agrpc::GrpcContext&, agrpc::OperationType type,
+                                       std::chrono::nanoseconds duration) noexcept
+    {
+        operation_latency_histograms.record(type, duration);
+    }
+};
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.run() with operation timing records every completed operation")
+{
+    operation_latency_histograms.reset();
+    grpc::Alarm alarm;
+    agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                asio::bind_executor(grpc_context,
+                                    [&](bool)
+                                    {
+                                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                    }));
+    asio::post(grpc_context, [] {});
+    asio::post(grpc_context, [] {});
+    grpc_context.run<OperationTimingRunTraits>();
+    CHECK_EQ(2, operation_latency_histograms.get(agrpc::OperationType::POST).count());
+#ifdef AGRPC_ENABLE_OPERATION_TYPE_TRACKING
+    const auto& alarm_histogram = operation_latency_histograms.get(agrpc::OperationType::WAIT);
+#else
+    const auto& alarm_histogram = operation_latency_histograms.get(agrpc::OperationType::UNKNOWN);
+#endif
+    CHECK_EQ(1, alarm_histogram.count());
+    CHECK_LE(std::chrono::milliseconds(2), alarm_histogram.percentile(100.0));
+}
+
+TEST_CASE("OperationType can be converted to string")
+{
+    CHECK_EQ(std::string_view{"POST"}, agrpc::to_string(agrpc::OperationType::POST));
+    CHECK_EQ(std::string_view{"WRITE_AND_FINISH"}, agrpc::to_string(agrpc::OperationType::WRITE_AND_FINISH));
+    CHECK_EQ(std::string_view{"READ_INITIAL_METADATA"}, agrpc::to_string(agrpc::OperationType::READ_INITIAL_METADATA));
+}
+
+TEST_CASE("SlabMemoryResource serves reserved blocks without calling the upstream resource")
+{
+    using Resource = agrpc::detail::SlabMemoryResource;
+    test::CountingMemoryResource upstream;
+    {
+        Resource resource{&upstream};
+        resource.reserve(64, 4);
+        CHECK_EQ(1, upstream.allocations);
+        resource.reserve(50, 4);
+        CHECK_EQ(1, upstream.allocations);
+        std::array<void*, 4> blocks{};
+        for (auto& block : blocks)
+        {
+            block = resource.allocate(64, alignof(std::max_align_t));
+        }
+        CHECK_EQ(1, upstream.allocations);
+        CHECK_EQ(4, std::set<void*>(blocks.begin(), blocks.end()).size());
+        for (auto* block : blocks)
+        {
+            resource.deallocate(block, 64, alignof(std::max_align_t));
+        }
+        void* p = resource.allocate(33, 8);
+        CHECK_EQ(1, upstream.allocations);
+        resource.deallocate(p, 33, 8);
+        p = resource.allocate(16, 8);
+        CHECK_EQ(2, upstream.allocations);
+        resource.deallocate(p, 16, 8);
+        p = resource.allocate(Resource::LARGEST_BLOCK_SIZE + 1, 8);
+        CHECK_EQ(3, upstream.allocations);
+        resource.deallocate(p, Resource::LARGEST_BLOCK_SIZE + 1, 8);
+        CHECK_EQ(1, upstream.deallocations);
+    }
+    CHECK_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST_CASE("SlabMemoryResource forwards to the upstream resource once a size class is exhausted")
+{
+    using Resource = agrpc::detail::SlabMemoryResource;
+    static constexpr auto ALIGNMENT = alignof(std::max_align_t);
+    test::CountingMemoryResource upstream;
+    {
+        Resource resource{&upstream};
+        resource.reserve(32, Resource::MAX_BLOCKS_PER_SIZE_CLASS + 1);
+        CHECK_EQ(1, upstream.allocations);
+        std::vector<void*> blocks(Resource::MAX_BLOCKS_PER_SIZE_CLASS);
+        for (auto& block : blocks)
+        {
+            block = resource.allocate(32, ALIGNMENT);
+        }
+        CHECK_EQ(1, upstream.allocations);
+        void* upstream_block = resource.allocate(32, ALIGNMENT);
+        CHECK_EQ(2, upstream.allocations);
+        resource.deallocate(blocks.back(), 32, ALIGNMENT);
+        CHECK_EQ(0, upstream.deallocations);
+        resource.deallocate(upstream_block, 32, ALIGNMENT);
+        CHECK_EQ(1, upstream.deallocations);
+        blocks.back() = resource.allocate(32, ALIGNMENT);
+        CHECK_EQ(2, upstream.allocations);
+        for (auto* block : blocks)
+        {
+            resource.deallocate(block, 32, ALIGNMENT);
+        }
+        CHECK_EQ(1, upstream.deallocations);
+    }
+    CHECK_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.reserve() pre-allocates memory for local operations")
+{
+    grpc_context.reserve(128, 32);
+    bool invoked{false};
+    asio::post(grpc_context,
+               [&]
+               {
+                   asio::post(grpc_context,
+                              [&]
+                              {
+                                  invoked = true;
+                              });
+               });
+    grpc_context.run();
+    CHECK(invoked);
+}
+
+TEST_CASE("GrpcContext obtains memory for local operations from the provided upstream resource")
+{
+    test::CountingMemoryResource upstream;
+    {
+        agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>(), &upstream};
+        CHECK_EQ(&upstream, grpc_context.get_upstream_resource());
+        bool invoked{false};
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       asio::post(grpc_context,
+                                  [&]
+                                  {
+                                      invoked = true;
+                                  });
+                   });
+        grpc_context.run();
+        CHECK(invoked);
+        CHECK_EQ(1, upstream.allocations);
+    }
+    CHECK_EQ(1, upstream.deallocations);
+}
+
+TEST_CASE("RemoteMemoryPool hands deallocated blocks back in batches")
+{
+    using Pool = agrpc::detail::RemoteMemoryPool;
+    Pool pool;
+    CHECK(pool.empty());
+    pool.reserve(Pool::RETURN_BATCH_SIZE);
+    CHECK_FALSE(pool.empty());
+    std::vector<void*> blocks;
+    for (std::size_t i{}; i < Pool::RETURN_BATCH_SIZE; ++i)
+    {
+        blocks.emplace_back(pool.allocate(Pool::BLOCK_SIZE, alignof(std::max_align_t)));
+    }
+    CHECK_EQ(Pool::RETURN_BATCH_SIZE, std::set<void*>(blocks.begin(), blocks.end()).size());
+    auto* overflow = pool.allocate(8, 8);
+    CHECK_EQ(blocks.end(), std::find(blocks.begin(), blocks.end(), overflow));
+    pool.deallocate(overflow, 8, 8);
+    for (std::size_t i{1}; i < Pool::RETURN_BATCH_SIZE; ++i)
+    {
+        pool.deallocate(blocks[i], Pool::BLOCK_SIZE, alignof(std::max_align_t));
+    }
+    overflow = pool.allocate(8, 8);
+    CHECK_EQ(blocks.end(), std::find(blocks.begin(), blocks.end(), overflow));
+    pool.deallocate(overflow, 8, 8);
+    pool.deallocate(blocks[0], Pool::BLOCK_SIZE, alignof(std::max_align_t));
+    auto* reused = pool.allocate(8, 8);
+    CHECK_NE(blocks.end(), std::find(blocks.begin(), blocks.end(), reused));
+    pool.deallocate(reused, 8, 8);
+}
+
+TEST_CASE_FIXTURE(test::GrpcContextTest, "GrpcContext.reserve_remote_operations() pools operations posted from threads")
+{
+    static constexpr int THREAD_COUNT = 4;
+    static constexpr int POST_COUNT = 1000;
+    grpc_context.reserve_remote_operations(16);
+    std::atomic_int invocations{};
+    std::vector<std::thread> threads;
+    grpc_context.work_started();
+    for (int i{}; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (int j{}; j < POST_COUNT; ++j)
+                {
+                    asio::post(grpc_context,
+                               [&]
+                               {
+                                   if (THREAD_COUNT * POST_COUNT == ++invocations)
+                                   {
+                                       grpc_context.work_finished();
+                                   }
+                               });
+                }
+            });
+    }
+    grpc_context.run();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    CHECK_EQ(THREAD_COUNT * POST_COUNT, invocations.load());
+}
+
+TEST_CASE("RemoteMemoryPool with fewer blocks than a return batch keeps serving sequential allocations")
+{
+    using Pool = agrpc::detail::RemoteMemoryPool;
+    static constexpr auto ALIGNMENT = alignof(std::max_align_t);
+    Pool pool;
+    pool.reserve(2);
+    for (std::size_t i{}; i < 3 * Pool::RETURN_BATCH_SIZE; ++i)
+    {
+        void* block{};
+        std::thread{[&]
+                    {
+                        block = pool.allocate(Pool::BLOCK_SIZE, ALIGNMENT);
+                    }}
+            .join();
+        CHECK(pool.owns(block));
+        pool.deallocate(block, Pool::BLOCK_SIZE, ALIGNMENT);
+    }
+}
+
+struct MultiThreadedGrpcContextTest
+{
+    static constexpr std::size_t THREAD_COUNT = 4;
+
+    agrpc::GrpcContext grpc_context{std::make_unique<grpc::CompletionQueue>(), THREAD_COUNT};
+    std::vector<std::thread> threads;
+
+    void start_threads()
+    {
+        for (std::size_t i{}; i < THREAD_COUNT; ++i)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    grpc_context.run();
+                });
+        }
+    }
+
+    void join_threads()
+    {
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+TEST_CASE_FIXTURE(MultiThreadedGrpcContextTest, "multi-threaded GrpcContext completes local and remote operations")
+{
+    static constexpr int POST_COUNT = 200;
+    std::atomic_int count{};
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    grpc_context.work_started();
+    start_threads();
+    for (int i{}; i < POST_COUNT; ++i)
+    {
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       {
+                           std::lock_guard lock{mutex};
+                           thread_ids.emplace(std::this_thread::get_id());
+                       }
+                       asio::post(grpc_context,
+                                  [&]
+                                  {
+                                      if (2 * POST_COUNT == ++count)
+                                      {
+                                          grpc_context.work_finished();
+                                      }
+                                  });
+                       ++count;
+                   });
+    }
+    join_threads();
+    CHECK_EQ(2 * POST_COUNT, count.load());
+    CHECK_FALSE(thread_ids.empty());
+    CHECK_FALSE(thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST_CASE_FIXTURE(MultiThreadedGrpcContextTest, "multi-threaded GrpcContext completes alarms")
+{
+    std::atomic_int count{};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::set<std::thread::id> thread_ids;
+    std::array<grpc::Alarm, 20> alarms;
+    for (auto& alarm : alarms)
+    {
+        agrpc::wait(alarm, test::ten_milliseconds_from_now(),
+                    asio::bind_executor(grpc_context,
+                                        [&](bool ok)
+                                        {
+                                            CHECK(ok);
+                                            ++count;
+                                            // Blocks this thread until another one has drained an alarm from the
+                                            // completion queue
+                                            std::unique_lock lock{mutex};
+                                            thread_ids.emplace(std::this_thread::get_id());
+                                            cv.notify_all();
+                                            cv.wait_for(lock, std::chrono::seconds(5),
+                                                        [&]
+                                                        {
+                                                            return thread_ids.size() > 1;
+                                                        });
+                                        }));
+    }
+    start_threads();
+    join_threads();
+    CHECK_EQ(20, count.load());
+    CHECK_LT(1, thread_ids.size());
+}
+
+TEST_CASE_FIXTURE(MultiThreadedGrpcContextTest, "multi-threaded GrpcContext.stop() wakes up all threads")
+{
+    grpc_context.work_started();
+    start_threads();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SUBCASE("stop from outside") { grpc_context.stop(); }
+    SUBCASE("stop from inside")
+    {
+        asio::post(grpc_context,
+                   [&]
+                   {
+                       grpc_context.stop();
+                   });
+    }
+    join_threads();
+    CHECK(grpc_context.is_stopped());
+    grpc_context.work_finished();
+}
+
+TEST_CASE_FIXTURE(MultiThreadedGrpcContextTest, "multi-threaded GrpcContext.run() after stop() while another thread runs")
+{
+    bool joined{false};
+    grpc_context.work_started();
+    asio::post(grpc_context,
+               [&]
+               {
+                   grpc_context.stop();
+                   std::thread{[&]
+                               {
+                                   grpc_context.run();
+                               }}
+                       .join();
+                   joined = true;
+               });
+    grpc_context.run();
+    CHECK(joined);
+    CHECK(grpc_context.is_stopped());
+    grpc_context.work_finished();
+}
+}
@@ -0,0 +1,299 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/v1/test.grpc.pb.h"
+#include "utils/asioUtils.hpp"
+#include "utils/freePort.hpp"
+#include "utils/rpc.hpp"
+
+#include <agrpc/grpcContextPool.hpp>
+#include <agrpc/repeatedlyRequest.hpp>
+#include <agrpc/rpc.hpp>
+#include <doctest/doctest.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
+{
+TEST_CASE("GrpcContextPool round-robin selects every GrpcContext in turn")
+{
+    agrpc::GrpcContextPool pool{3};
+    CHECK_EQ(3, pool.size());
+    CHECK_EQ(&pool.get_context(0), &pool.get_next_context());
+    CHECK_EQ(&pool.get_context(1), &pool.get_next_context());
+    CHECK_EQ(&pool.get_context(2), &pool.get_next_context());
+    CHECK_EQ(&pool.get_context(0), &pool.get_next_context(agrpc::GrpcContextPoolPolicy::ROUND_ROBIN));
+    CHECK_EQ(pool.get_context(1).get_executor(), pool.get_next_executor());
+}
+
+TEST_CASE("GrpcContextPool least-outstanding-work selects the GrpcContext with the fewest work")
+{
+    agrpc::GrpcContextPool pool{3};
+    pool.get_context(0).work_started();
+    pool.get_context(2).work_started();
+    pool.get_context(2).work_started();
+    for (int i{}; i < 4; ++i)
+    {
+        CHECK_EQ(&pool.get_context(1), &pool.get_next_context(agrpc::GrpcContextPoolPolicy::LEAST_OUTSTANDING_WORK));
+    }
+    pool.get_context(1).work_started();
+    pool.get_context(1).work_started();
+    CHECK_EQ(&pool.get_context(0), &pool.get_next_context(agrpc::GrpcContextPoolPolicy::LEAST_OUTSTANDING_WORK));
+    pool.get_context(0).work_finished();
+    pool.get_context(1).work_finished();
+    pool.get_context(1).work_finished();
+    pool.get_context(2).work_finished();
+    pool.get_context(2).work_finished();
+}
+
+TEST_CASE("GrpcContextPool runs each GrpcContext on its own thread")
+{
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic_int invocations{};
+    {
+        agrpc::GrpcContextPool pool{4};
+        for (std::size_t i{}; i < pool.size() * 2; ++i)
+        {
+            asio::post(pool.get_next_executor(),
+                       [&]
+                       {
+                           std::lock_guard lock{mutex};
+                           thread_ids.emplace(std::this_thread::get_id());
+                           ++invocations;
+                       });
+        }
+        pool.start();
+        pool.join();
+    }
+    CHECK_EQ(8, invocations.load());
+    CHECK_EQ(4, thread_ids.size());
+    CHECK_FALSE(thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST_CASE("GrpcContextPool.stop() causes all threads to exit")
+{
+    agrpc::GrpcContextPool pool{2};
+    pool.start();
+    pool.stop();
+    pool.join();
+    CHECK(pool.get_context(0).is_stopped());
+    CHECK(pool.get_context(1).is_stopped());
+}
+
+TEST_CASE("GrpcContextPool with work stealing lets an idle GrpcContext complete handlers posted to a busy one")
+{
+    std::atomic_bool stolen_handler_invoked{};
+    std::thread::id busy_thread_id;
+    std::thread::id stolen_thread_id;
+    const auto wait_until_stolen_handler_invoked = [&]
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!stolen_handler_invoked && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    {
+        agrpc::GrpcContextPool pool{2};
+        pool.enable_work_stealing();
+        auto& busy_grpc_context = pool.get_context(0);
+        asio::post(busy_grpc_context,
+                   [&]
+                   {
+                       busy_thread_id = std::this_thread::get_id();
+                       asio::post(busy_grpc_context,
+                                  [&]
+                                  {
+                                      stolen_thread_id = std::this_thread::get_id();
+                                      stolen_handler_invoked = true;
+                                  });
+                       wait_until_stolen_handler_invoked();
+                   });
+        pool.start();
+        wait_until_stolen_handler_invoked();
+        pool.join();
+    }
+    CHECK(stolen_handler_invoked);
+    CHECK_NE(busy_thread_id, stolen_thread_id);
+}
+
+TEST_CASE("GrpcContextPool with work stealing completes all posted handlers")
+{
+    static constexpr int POST_COUNT = 1000;
+    std::atomic_int invocations{};
+    {
+        agrpc::GrpcContextPool pool{3};
+        pool.enable_work_stealing();
+        pool.start();
+        for (int i{}; i < POST_COUNT; ++i)
+        {
+            asio::post(pool.get_context(0),
+                       [&]
+                       {
+                           asio::post(pool.get_context(1),
+                                      [&]
+                                      {
+                                          ++invocations;
+                                      });
+                       });
+        }
+        // join() would allow the second GrpcContext to run out of work before all handlers have been posted to it
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (POST_COUNT != invocations && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        pool.join();
+        CHECK_EQ(0, agrpc::detail::GrpcContextImplementation::get_outstanding_work(pool.get_context(0)));
+        CHECK_EQ(0, agrpc::detail::GrpcContextImplementation::get_outstanding_work(pool.get_context(1)));
+        CHECK_EQ(0, agrpc::detail::GrpcContextImplementation::get_outstanding_work(pool.get_context(2)));
+    }
+    CHECK_EQ(POST_COUNT, invocations.load());
+}
+
+struct GrpcContextPoolServerTest
+{
+    std::string address{std::string{"0.0.0.0:"} + std::to_string(test::get_free_port())};
+    grpc::ServerBuilder builder;
+    test::v1::Test::AsyncService service;
+    std::unique_ptr<grpc::Server> server;
+    agrpc::GrpcContextPool pool{2, [&]
+                                {
+                                    return builder.AddCompletionQueue();
+                                }};
+
+    GrpcContextPoolServerTest()
+    {
+        builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+        builder.RegisterService(&service);
+        server = builder.BuildAndStart();
+    }
+};
+
+TEST_CASE_FIXTURE(GrpcContextPoolServerTest, "GrpcContextPool.repeatedly_request registers on every GrpcContext")
+{
+    std::mutex mutex;
+    std::set<const agrpc::GrpcContext*> handling_contexts;
+    std::atomic_int request_count{};
+    pool.repeatedly_request(&test::v1::Test::AsyncService::RequestUnary, service,
+                            [&](agrpc::GrpcContext& grpc_context)
+                            {
+                                return test::RpcSpawner{
+                                    grpc_context,
+                                    [&, context = &grpc_context](
+                                        grpc::ServerContext&, test::msg::Request& request,
+                                        grpc::ServerAsyncResponseWriter<test::msg::Response>& writer,
+                                        asio::yield_context yield)
+                                    {
+                                        {
+                                            std::lock_guard lock{mutex};
+                                            handling_contexts.emplace(context);
+                                        }
+                                        ++request_count;
+                                        test::msg::Response response;
+                                        response.set_integer(request.integer() / 2);
+                                        agrpc::finish(writer, response, grpc::Status::OK, yield);
+                                    }};
+                            });
+    pool.start();
+    auto channel = grpc::CreateChannel(std::string{"localhost:"} + address.substr(address.find(':') + 1),
+                                       grpc::InsecureChannelCredentials());
+    auto stub = test::v1::Test::NewStub(channel);
+    agrpc::GrpcContext client_grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    asio::spawn(client_grpc_context,
+                [&](asio::yield_context yield)
+                {
+                    for (int i{}; i < 20; ++i)
+                    {
+                        test::client_perform_unary_success(client_grpc_context, *stub, yield);
+                    }
+                });
+    client_grpc_context.run();
+    server->Shutdown();
+    pool.join();
+    CHECK_EQ(20, request_count.load());
+    CHECK_FALSE(handling_contexts.empty());
+    for (const auto* context : handling_contexts)
+    {
+        CHECK((context == &pool.get_context(0) || context == &pool.get_context(1)));
+    }
+}
+
+TEST_CASE_FIXTURE(GrpcContextPoolServerTest,
+                  "GrpcContextPool with work stealing runs repeatedly_request that releases RPCs on another thread")
+{
+    static constexpr int REQUEST_COUNT = 50;
+    std::atomic_int request_count{};
+    pool.enable_work_stealing();
+    agrpc::RepeatedlyRequestOptions options;
+    options.max_recycled_rpc_contexts = 1;
+    options.max_in_flight_handlers = 1;
+    for (std::size_t i{}; i < pool.size(); ++i)
+    {
+        auto& grpc_context = pool.get_context(i);
+        auto* other_grpc_context = &pool.get_context((i + 1) % pool.size());
+        agrpc::repeatedly_request(
+            &test::v1::Test::AsyncService::RequestUnary, service, options,
+            asio::bind_executor(
+                grpc_context,
+                [&request_count, &grpc_context, other_grpc_context](auto&& rpc_context)
+                {
+                    ++request_count;
+                    test::msg::Response response;
+                    response.set_integer(21);
+                    auto& responder = rpc_context.responder();
+                    // Releasing the RPC context on another GrpcContext's thread resumes the parked request through
+                    // the remote work queue of the owning GrpcContext
+                    agrpc::finish(responder, response, grpc::Status::OK,
+                                  asio::bind_executor(grpc_context,
+                                                      [other_grpc_context, c = std::move(rpc_context)](bool) mutable
+                                                      {
+                                                          asio::post(*other_grpc_context,
+                                                                     [c = std::move(c)]
+                                                                     {
+                                                                     });
+                                                      }));
+                }));
+    }
+    pool.start();
+    auto channel = grpc::CreateChannel(std::string{"localhost:"} + address.substr(address.find(':') + 1),
+                                       grpc::InsecureChannelCredentials());
+    auto stub = test::v1::Test::NewStub(channel);
+    agrpc::GrpcContext client_grpc_context{std::make_unique<grpc::CompletionQueue>()};
+    for (int i{}; i < 5; ++i)
+    {
+        asio::spawn(client_grpc_context,
+                    [&](asio::yield_context yield)
+                    {
+                        for (int j{}; j < REQUEST_COUNT / 5; ++j)
+                        {
+                            test::client_perform_unary_success(client_grpc_context, *stub, yield);
+                        }
+                    });
+    }
+    client_grpc_context.run();
+    server->Shutdown();
+    pool.join();
+    CHECK_EQ(REQUEST_COUNT, request_count.load());
+}
+}
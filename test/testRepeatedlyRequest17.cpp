@@ -17,14 +17,21 @@
 #include "utils/grpcClientServerTest.hpp"
 #include "utils/grpcContextTest.hpp"
 #include "utils/rpc.hpp"
+#include "utils/time.hpp"
 
 #include <agrpc/repeatedlyRequest.hpp>
+#include <agrpc/repeatedlyRequestArenaOptions.hpp>
 #include <agrpc/rpc.hpp>
+#include <agrpc/wait.hpp>
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <boost/optional.hpp>
+#include <memory>
+#include <set>
 #include <thread>
+#include <vector>
 
 DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
 {
@@ -172,6 +179,259 @@ TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "RepeatedlyRequestContext member fu
     grpc_context.run();
 }
 
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request with options recycles RPC contexts")
+{
+    static constexpr int REQUEST_COUNT = 6;
+    std::set<const test::msg::Request*> requests;
+    int request_count{};
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, agrpc::RepeatedlyRequestOptions{2},
+        test::RpcSpawner{grpc_context,
+                         [&](grpc::ServerContext&, test::msg::Request& request,
+                             grpc::ServerAsyncResponseWriter<test::msg::Response>& writer, asio::yield_context yield)
+                         {
+                             CHECK_EQ(42, request.integer());
+                             requests.emplace(&request);
+                             ++request_count;
+                             test::msg::Response response;
+                             response.set_integer(21);
+                             CHECK(agrpc::finish(writer, response, grpc::Status::OK, yield));
+                         },
+                         get_allocator()});
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    for (int i{}; i < REQUEST_COUNT; ++i)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+    CHECK_GE(3, requests.size());
+    CHECK(allocator_has_been_used());
+}
+
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request with arena options creates requests on the arena")
+{
+    static constexpr int REQUEST_COUNT = 4;
+    int request_count{};
+    agrpc::RepeatedlyRequestArenaOptions options;
+    options.max_recycled_rpc_contexts = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(
+            get_executor(),
+            [&](auto&& rpc_context)
+            {
+                auto& arena = rpc_context.arena();
+                CHECK(std::is_same_v<google::protobuf::Arena&, decltype(arena)>);
+                CHECK_EQ(&arena, rpc_context.request().GetArena());
+                CHECK_EQ(42, rpc_context.request().integer());
+                ++request_count;
+                auto* response = google::protobuf::Arena::CreateMessage<test::msg::Response>(&arena);
+                response->set_integer(21);
+                auto& responder = rpc_context.responder();
+                agrpc::finish(responder, *response, grpc::Status::OK,
+                              asio::bind_executor(get_executor(), [c = std::move(rpc_context)](bool) {}));
+            }));
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    for (int i{}; i < REQUEST_COUNT; ++i)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+}
+
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request with multiple outstanding requests")
+{
+    static constexpr int REQUEST_COUNT = 8;
+    int request_count{};
+    agrpc::RepeatedlyRequestOptions options;
+    options.outstanding_requests = 4;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(
+            get_executor(),
+            [&](auto&& rpc_context)
+            {
+                CHECK_EQ(42, rpc_context.request().integer());
+                ++request_count;
+                test::msg::Response response;
+                response.set_integer(21);
+                auto& responder = rpc_context.responder();
+                agrpc::finish(responder, response, grpc::Status::OK,
+                              asio::bind_executor(get_executor(), [c = std::move(rpc_context)](bool) {}));
+            }));
+    int finished_clients{};
+    for (int i{}; i < REQUEST_COUNT; ++i)
+    {
+        asio::spawn(get_executor(),
+                    [&](asio::yield_context yield)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                        if (++finished_clients == REQUEST_COUNT)
+                        {
+                            grpc_context.stop();
+                        }
+                    });
+    }
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+}
+
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request with options limits the number of in-flight handlers")
+{
+    static constexpr int REQUEST_COUNT = 4;
+    int request_count{};
+    int in_flight{};
+    int max_in_flight{};
+    agrpc::RepeatedlyRequestOptions options;
+    options.max_in_flight_handlers = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(
+            get_executor(),
+            [&](auto&& rpc_context)
+            {
+                ++request_count;
+                max_in_flight = (std::max)(max_in_flight, ++in_flight);
+                auto alarm = std::make_unique<grpc::Alarm>();
+                auto& alarm_ref = *alarm;
+                agrpc::wait(alarm_ref, test::ten_milliseconds_from_now(),
+                            asio::bind_executor(get_executor(),
+                                                [&, a = std::move(alarm), c = std::move(rpc_context)](bool) mutable
+                                                {
+                                                    test::msg::Response response;
+                                                    response.set_integer(21);
+                                                    auto& responder = c.responder();
+                                                    agrpc::finish(responder, response, grpc::Status::OK,
+                                                                  asio::bind_executor(get_executor(),
+                                                                                      [&, c = std::move(c)](bool)
+                                                                                      {
+                                                                                          --in_flight;
+                                                                                      }));
+                                                }));
+            }));
+    int finished_clients{};
+    for (int i{}; i < REQUEST_COUNT; ++i)
+    {
+        asio::spawn(get_executor(),
+                    [&](asio::yield_context yield)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                        if (++finished_clients == REQUEST_COUNT)
+                        {
+                            grpc_context.stop();
+                        }
+                    });
+    }
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+    CHECK_EQ(1, max_in_flight);
+}
+
+grpc::StatusCode client_perform_unary(agrpc::GrpcContext& grpc_context, test::v1::Test::Stub& stub,
+                                      asio::yield_context yield)
+{
+    grpc::ClientContext client_context;
+    client_context.set_deadline(test::five_seconds_from_now());
+    test::msg::Request request;
+    request.set_integer(42);
+    auto reader = stub.AsyncUnary(&client_context, request, agrpc::get_completion_queue(grpc_context));
+    test::msg::Response response;
+    grpc::Status status;
+    agrpc::finish(*reader, response, status, yield);
+    return status.error_code();
+}
+
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request admission policy rejects RPCs above in-flight limit")
+{
+    int request_count{};
+    std::vector<grpc::StatusCode> status_codes;
+    agrpc::RepeatedlyRequestOptions options;
+    options.outstanding_requests = 2;
+    options.admission_policy.max_in_flight_handlers = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(
+            get_executor(),
+            [&](auto&& rpc_context)
+            {
+                ++request_count;
+                auto alarm = std::make_unique<grpc::Alarm>();
+                auto& alarm_ref = *alarm;
+                agrpc::wait(alarm_ref, test::hundred_milliseconds_from_now(),
+                            asio::bind_executor(get_executor(),
+                                                [&, a = std::move(alarm), c = std::move(rpc_context)](bool) mutable
+                                                {
+                                                    test::msg::Response response;
+                                                    auto& responder = c.responder();
+                                                    agrpc::finish(responder, response, grpc::Status::OK,
+                                                                  asio::bind_executor(get_executor(),
+                                                                                      [c = std::move(c)](bool) {}));
+                                                }));
+            }));
+    for (int i{}; i < 2; ++i)
+    {
+        asio::spawn(get_executor(),
+                    [&](asio::yield_context yield)
+                    {
+                        status_codes.emplace_back(client_perform_unary(grpc_context, *stub, yield));
+                        if (status_codes.size() == 2)
+                        {
+                            grpc_context.stop();
+                        }
+                    });
+    }
+    grpc_context.run();
+    CHECK_EQ(1, request_count);
+    REQUIRE(2 == status_codes.size());
+    CHECK_EQ(grpc::StatusCode::RESOURCE_EXHAUSTED, status_codes[0]);
+    CHECK_EQ(grpc::StatusCode::OK, status_codes[1]);
+}
+
+TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request admission policy rejects RPCs above request rate")
+{
+    int request_count{};
+    std::vector<grpc::StatusCode> status_codes;
+    agrpc::RepeatedlyRequestOptions options;
+    options.admission_policy.requests_per_second = 0.001;
+    options.admission_policy.burst_size = 1;
+    agrpc::repeatedly_request(&test::v1::Test::AsyncService::RequestUnary, service, options,
+                              asio::bind_executor(get_executor(),
+                                                  [&](auto&& rpc_context)
+                                                  {
+                                                      ++request_count;
+                                                      test::msg::Response response;
+                                                      auto& responder = rpc_context.responder();
+                                                      agrpc::finish(responder, response, grpc::Status::OK,
+                                                                    asio::bind_executor(get_executor(),
+                                                                                        [c = std::move(rpc_context)](
+                                                                                            bool) {}));
+                                                  }));
+    asio::spawn(get_executor(),
+                [&](asio::yield_context yield)
+                {
+                    for (int i{}; i < 3; ++i)
+                    {
+                        status_codes.emplace_back(client_perform_unary(grpc_context, *stub, yield));
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_EQ(1, request_count);
+    const std::vector expected_status_codes{grpc::StatusCode::OK, grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                            grpc::StatusCode::RESOURCE_EXHAUSTED};
+    CHECK_EQ(expected_status_codes, status_codes);
+}
+
 TEST_CASE_FIXTURE(GrpcRepeatedlyRequestTest, "repeatedly_request tracks work of completion_handler's executor")
 {
     int order{};
@@ -18,10 +18,15 @@
 #include "utils/rpc.hpp"
 
 #include <agrpc/repeatedlyRequest.hpp>
+#include <agrpc/repeatedlyRequestArenaOptions.hpp>
 #include <agrpc/rpc.hpp>
 #include <agrpc/wait.hpp>
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <set>
+#include <vector>
+
 #ifdef AGRPC_ASIO_HAS_CO_AWAIT
 DOCTEST_TEST_SUITE(ASIO_GRPC_TEST_CPP_VERSION)
 {
@@ -159,6 +164,153 @@ TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable repeatedly_request trac
     CHECK(invoked);
 }
 
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable repeatedly_request with options recycles RPC contexts")
+{
+    static constexpr int REQUEST_COUNT = 4;
+    int request_count{};
+    std::set<const test::msg::Request*> requests;
+    agrpc::RepeatedlyRequestOptions options;
+    options.max_recycled_rpc_contexts = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(get_executor(),
+                            [&](grpc::ServerContext&, test::msg::Request& request,
+                                grpc::ServerAsyncResponseWriter<test::msg::Response>& writer) -> asio::awaitable<void>
+                            {
+                                CHECK_EQ(42, request.integer());
+                                ++request_count;
+                                requests.emplace(&request);
+                                test::msg::Response response;
+                                response.set_integer(21);
+                                co_await agrpc::finish(writer, response, grpc::Status::OK);
+                            }));
+    asio::spawn(grpc_context,
+                [&](auto&& yield)
+                {
+                    for (int i{}; i < REQUEST_COUNT; ++i)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+    CHECK_GE(2, requests.size());
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable repeatedly_request with options limits in-flight handlers")
+{
+    static constexpr int REQUEST_COUNT = 4;
+    int request_count{};
+    int in_flight{};
+    int max_in_flight{};
+    agrpc::RepeatedlyRequestOptions options;
+    options.max_in_flight_handlers = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(get_executor(),
+                            [&](grpc::ServerContext&, test::msg::Request&,
+                                grpc::ServerAsyncResponseWriter<test::msg::Response>& writer) -> asio::awaitable<void>
+                            {
+                                ++request_count;
+                                max_in_flight = (std::max)(max_in_flight, ++in_flight);
+                                grpc::Alarm alarm;
+                                co_await agrpc::wait(alarm, test::ten_milliseconds_from_now());
+                                test::msg::Response response;
+                                response.set_integer(21);
+                                co_await agrpc::finish(writer, response, grpc::Status::OK);
+                                --in_flight;
+                            }));
+    int finished_clients{};
+    for (int i{}; i < REQUEST_COUNT; ++i)
+    {
+        asio::spawn(grpc_context,
+                    [&](auto&& yield)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                        if (++finished_clients == REQUEST_COUNT)
+                        {
+                            grpc_context.stop();
+                        }
+                    });
+    }
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+    CHECK_EQ(1, max_in_flight);
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable repeatedly_request with arena options")
+{
+    static constexpr int REQUEST_COUNT = 4;
+    int request_count{};
+    agrpc::RepeatedlyRequestArenaOptions options;
+    options.max_recycled_rpc_contexts = 1;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(get_executor(),
+                            [&](grpc::ServerContext&, test::msg::Request& request,
+                                grpc::ServerAsyncResponseWriter<test::msg::Response>& writer) -> asio::awaitable<void>
+                            {
+                                CHECK_NE(nullptr, request.GetArena());
+                                CHECK_EQ(42, request.integer());
+                                ++request_count;
+                                test::msg::Response response;
+                                response.set_integer(21);
+                                co_await agrpc::finish(writer, response, grpc::Status::OK);
+                            }));
+    asio::spawn(grpc_context,
+                [&](auto&& yield)
+                {
+                    for (int i{}; i < REQUEST_COUNT; ++i)
+                    {
+                        test::client_perform_unary_success(grpc_context, *stub, yield);
+                    }
+                    grpc_context.stop();
+                });
+    grpc_context.run();
+    CHECK_EQ(REQUEST_COUNT, request_count);
+}
+
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "awaitable repeatedly_request admission policy rejects RPCs above rate")
+{
+    int request_count{};
+    std::vector<grpc::StatusCode> status_codes;
+    agrpc::RepeatedlyRequestOptions options;
+    options.admission_policy.requests_per_second = 0.001;
+    agrpc::repeatedly_request(
+        &test::v1::Test::AsyncService::RequestUnary, service, options,
+        asio::bind_executor(get_executor(),
+                            [&](grpc::ServerContext&, test::msg::Request&,
+                                grpc::ServerAsyncResponseWriter<test::msg::Response>& writer) -> asio::awaitable<void>
+                            {
+                                ++request_count;
+                                test::msg::Response response;
+                                co_await agrpc::finish(writer, response, grpc::Status::OK);
+                            }));
+    test::co_spawn(grpc_context,
+                   [&]() -> asio::awaitable<void>
+                   {
+                       for (int i{}; i < 3; ++i)
+                       {
+                           grpc::ClientContext client_context;
+                           client_context.set_deadline(test::five_seconds_from_now());
+                           test::msg::Request request;
+                           auto reader =
+                               stub->AsyncUnary(&client_context, request, agrpc::get_completion_queue(grpc_context));
+                           test::msg::Response response;
+                           grpc::Status status;
+                           co_await agrpc::finish(*reader, response, status);
+                           status_codes.emplace_back(status.error_code());
+                       }
+                       grpc_context.stop();
+                   });
+    grpc_context.run();
+    CHECK_EQ(1, request_count);
+    const std::vector expected_status_codes{grpc::StatusCode::OK, grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                            grpc::StatusCode::RESOURCE_EXHAUSTED};
+    CHECK_EQ(expected_status_codes, status_codes);
+}
+
 #ifdef AGRPC_ASIO_HAS_CANCELLATION_SLOT
 TEST_CASE_FIXTURE(test::GrpcClientServerTest, "asio use_sender repeatedly_request unary")
 {
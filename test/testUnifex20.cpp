@@ -487,6 +487,38 @@ TEST_CASE_FIXTURE(test::GrpcClientServerTest, "unifex::task unary")
     CHECK(client_finish_ok);
 }
 
+TEST_CASE_FIXTURE(test::GrpcClientServerTest, "unifex::task unary_call")
+{
+    bool server_finish_ok{false};
+    grpc::Status status;
+    test::msg::Response response;
+    unifex::sync_wait(unifex::when_all(
+        [&]() -> unifex::task<void>
+        {
+            auto context = std::make_shared<ServerUnaryRequestContext>(server_context);
+            CHECK(co_await agrpc::request(&test::v1::Test::AsyncService::RequestUnary, service, server_context,
+                                          context->request, context->writer, use_sender()));
+            context->response.set_integer(context->request.integer());
+            server_finish_ok =
+                co_await agrpc::finish(context->writer, context->response, grpc::Status::OK, use_sender());
+        }(),
+        [&]() -> unifex::task<void>
+        {
+            test::msg::Request request;
+            request.set_integer(42);
+            status = co_await agrpc::unary_call(&test::v1::Test::Stub::PrepareAsyncUnary, *stub, client_context,
+                                                request, response, use_sender());
+        }(),
+        unifex::then(unifex::just(),
+                     [&]
+                     {
+                         grpc_context.run();
+                     })));
+    CHECK(server_finish_ok);
+    CHECK(status.ok());
+    CHECK_EQ(42, response.integer());
+}
+
 TEST_CASE_FIXTURE(test::GrpcClientServerTest, "unifex repeatedly_request client streaming")
 {
     bool is_shutdown{false};
@@ -0,0 +1,52 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/countingMemoryResource.hpp"
+
+#include "utils/memoryResource.hpp"
+
+#include <agrpc/detail/memoryResource.hpp>
+
+#include <cstddef>
+
+namespace test
+{
+CountingMemoryResource::CountingMemoryResource(agrpc::detail::pmr::memory_resource* upstream) noexcept
+    : upstream(upstream)
+{
+}
+
+agrpc::detail::pmr::polymorphic_allocator<std::byte> CountingMemoryResource::get_allocator() noexcept
+{
+    return agrpc::detail::pmr::polymorphic_allocator<std::byte>(this);
+}
+
+void* CountingMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++allocations;
+    bytes_allocated += bytes;
+    return upstream->allocate(bytes, alignment);
+}
+
+void CountingMemoryResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+    ++deallocations;
+    upstream->deallocate(p, bytes, alignment);
+}
+
+bool CountingMemoryResource::do_is_equal(const agrpc::detail::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+}  // namespace test
@@ -0,0 +1,50 @@
+// Copyright 2022 Dennis Hezel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AGRPC_UTILS_COUNTINGMEMORYRESOURCE_HPP
+#define AGRPC_UTILS_COUNTINGMEMORYRESOURCE_HPP
+
+#include "utils/memoryResource.hpp"
+
+#include <agrpc/detail/memoryResource.hpp>
+
+#include <cstddef>
+
+namespace test
+{
+// Memory resource that counts the allocations it forwards to its upstream resource. Pass it as the upstream resource
+// of a GrpcContext to count the memory that the GrpcContext's local pool obtains or bind its allocator to a completion
+// handler to count the allocations made on behalf of that handler.
+struct CountingMemoryResource : agrpc::detail::pmr::memory_resource
+{
+    agrpc::detail::pmr::memory_resource* upstream;
+    std::size_t allocations{};
+    std::size_t deallocations{};
+    std::size_t bytes_allocated{};
+
+    explicit CountingMemoryResource(
+        agrpc::detail::pmr::memory_resource* upstream = agrpc::detail::pmr::new_delete_resource()) noexcept;
+
+    agrpc::detail::pmr::polymorphic_allocator<std::byte> get_allocator() noexcept;
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const agrpc::detail::pmr::memory_resource& other) const noexcept override;
+};
+}  // namespace test
+
+#endif  // AGRPC_UTILS_COUNTINGMEMORYRESOURCE_HPP
@@ -16,6 +16,7 @@
 #define AGRPC_UTILS_GRPCCONTEXTTEST_HPP
 
 #include "utils/asioForward.hpp"
+#include "utils/countingMemoryResource.hpp"
 #include "utils/memoryResource.hpp"
 
 #include <agrpc/grpcContext.hpp>
@@ -36,7 +37,8 @@ struct GrpcContextTest
     std::unique_ptr<grpc::Server> server;
     std::array<std::byte, 4096> buffer{};
     agrpc::detail::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size()};
-    agrpc::GrpcContext grpc_context{builder.AddCompletionQueue()};
+    test::CountingMemoryResource upstream_resource;
+    agrpc::GrpcContext grpc_context{builder.AddCompletionQueue(), &upstream_resource};
 
     agrpc::GrpcExecutor get_executor() noexcept;
 